@@ -2931,6 +2931,11 @@ Amr::regrid (int  lbase,
         if (loadbalance_with_workestimates && !initial) {
             new_dmap[lev] = makeLoadBalanceDistributionMap(lev, time, new_grid_places[lev]);
         }
+        else if (new_dmap[lev].empty() && incremental_regrid && amr_level[lev] && !initial) {
+            new_dmap[lev] = DistributionMapping::makeIncremental(new_grid_places[lev],
+                                                                 amr_level[lev]->boxArray(),
+                                                                 amr_level[lev]->DistributionMap());
+        }
         else if (new_dmap[lev].empty()) {
 	    new_dmap[lev].define(new_grid_places[lev]);
 	}
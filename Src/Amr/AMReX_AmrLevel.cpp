@@ -2176,11 +2176,92 @@ AmrLevel::FillPatch (AmrLevel& amrlevel,
 {
     BL_ASSERT(dcomp+ncomp-1 <= leveldata.nComp());
     BL_ASSERT(boxGrow <= leveldata.nGrow());
+    if (boxGrow == 0 && amrlevel.parent->useIncrementalRegrid() &&
+        FillPatchIncremental(amrlevel, leveldata, time, index, scomp, ncomp, dcomp))
+    {
+        return;
+    }
     FillPatchIterator fpi(amrlevel, leveldata, boxGrow, time, index, scomp, ncomp);
     const MultiFab& mf_fillpatched = fpi.get_mf();
     MultiFab::Copy(leveldata, mf_fillpatched, 0, dcomp, ncomp, boxGrow);
 }
 
+bool
+AmrLevel::FillPatchIncremental (AmrLevel& amrlevel,
+                                MultiFab& leveldata,
+                                Real      time,
+                                int       index,
+                                int       scomp,
+                                int       ncomp,
+                                int       dcomp)
+{
+    const StateData& sd = amrlevel.state[index];
+
+    const MultiFab* src = nullptr;
+    if (sd.hasNewData() && time == sd.curTime()) {
+        src = &sd.newData();
+    } else if (sd.hasOldData() && time == sd.prevTime()) {
+        src = &sd.oldData();
+    }
+
+    if (src == nullptr || BoxArray::SameRefs(src->boxArray(), leveldata.boxArray())) {
+        return false;
+    }
+
+    BL_PROFILE("AmrLevel::FillPatchIncremental()");
+
+    const BoxArray& ba = leveldata.boxArray();
+    const DistributionMapping& dm = leveldata.DistributionMap();
+    const DistributionMapping& srcdm = src->DistributionMap();
+    Vector<int> old_index = amrex::findIdenticalBoxes(ba, src->boxArray());
+
+    // The boxes that have to be filled.  Everyone gets the same list.
+    BoxList bl(ba.ixType());
+    Vector<int> pmap, fill_index;
+    for (int i = 0, N = ba.size(); i < N; ++i) {
+        if (old_index[i] < 0 || srcdm[old_index[i]] != dm[i]) {
+            old_index[i] = -1;
+            bl.push_back(ba[i]);
+            pmap.push_back(dm[i]);
+            fill_index.push_back(i);
+        }
+    }
+
+    if (fill_index.size() == ba.size()) {
+        return false;
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(leveldata,true); mfi.isValid(); ++mfi)
+    {
+        const int j = old_index[mfi.index()];
+        if (j >= 0) {
+            const Box& bx = mfi.tilebox();
+            leveldata[mfi].copy((*src)[j], bx, scomp, bx, dcomp, ncomp);
+        }
+    }
+
+    if (!fill_index.empty())
+    {
+        MultiFab fill(BoxArray(std::move(bl)), DistributionMapping(std::move(pmap)),
+                      ncomp, 0, MFInfo(), leveldata.Factory());
+        FillPatchIterator fpi(amrlevel, fill, 0, time, index, scomp, ncomp);
+        const MultiFab& mf_fillpatched = fpi.get_mf();
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(mf_fillpatched,true); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            leveldata[fill_index[mfi.index()]].copy(mf_fillpatched[mfi], bx, 0, bx, dcomp, ncomp);
+        }
+    }
+
+    return true;
+}
+
 void
 AmrLevel::FillPatchAdd (AmrLevel& amrlevel,
                         MultiFab& leveldata,
@@ -73,6 +73,8 @@ AmrMesh::InitAmrMesh (int max_level_in, const Vector<int>& n_cell_in,
     use_fixed_upto_level   = 0;
     refine_grid_layout     = true;
     check_input            = true;
+    incremental_regrid     = false;
+    distributed_cluster    = false;
 
     use_new_chop         = false;
     iterate_on_new_grids = true;
@@ -373,6 +375,11 @@ AmrMesh::InitAmrMesh (int max_level_in, const Vector<int>& n_cell_in,
 
     pp.query("check_input", check_input);
 
+    pp.query("incremental_regrid", incremental_regrid);
+
+    // cluster the tags where they are and then merge the boxes
+    pp.query("distributed_cluster", distributed_cluster);
+
     finest_level = -1;
 
     if (check_input) checkInput();
@@ -699,10 +706,18 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
         // Create initial cluster containing all tagged points.
         //
 	Vector<IntVect> tagvec;
-	tags.collate(tagvec);
+        long ntags;
+        if (distributed_cluster) {
+            tags.localCollate(tagvec);
+            ntags = tagvec.size();
+            ParallelDescriptor::ReduceLongSum(ntags);
+        } else {
+            tags.collate(tagvec);
+            ntags = tagvec.size();
+        }
         tags.clear();
 
-        if (tagvec.size() > 0)
+        if (ntags > 0)
         {
             //
             // Created new level, now generate efficient grids.
@@ -713,23 +728,29 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
             //
             // Construct initial cluster.
             //
-            ClusterList clist(&tagvec[0], tagvec.size());
-            if (use_new_chop)
+            BoxList new_bx;
+            if (tagvec.size() > 0)
             {
-               clist.new_chop(grid_eff);
-            } else {
-               clist.chop(grid_eff);
+                ClusterList clist(&tagvec[0], tagvec.size());
+                if (use_new_chop)
+                {
+                   clist.new_chop(grid_eff);
+                } else {
+                   clist.chop(grid_eff);
+                }
+                BoxDomain bd;
+                bd.add(p_n[levc]);
+                clist.intersect(bd);
+                bd.clear();
+                //
+                // Efficient properly nested Clusters have been constructed
+                // now generate list of grids at level levf.
+                //
+                clist.boxList(new_bx);
+            }
+            if (distributed_cluster) {
+                MergeDistributedClusters(new_bx, tagvec, grid_eff, use_new_chop);
             }
-            BoxDomain bd;
-            bd.add(p_n[levc]);
-            clist.intersect(bd);
-            bd.clear();
-            //
-            // Efficient properly nested Clusters have been constructed
-            // now generate list of grids at level levf.
-            //
-            BoxList new_bx;
-            clist.boxList(new_bx);
             new_bx.refine(bf_lev[levc]);
             new_bx.simplify();
             BL_ASSERT(new_bx.isDisjoint());
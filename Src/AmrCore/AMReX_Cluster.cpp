@@ -1,7 +1,10 @@
 
 #include <algorithm>
+#include <map>
 #include <AMReX_Cluster.H>
 #include <AMReX_BoxDomain.H>
+#include <AMReX_BLProfiler.H>
+#include <AMReX_ParallelDescriptor.H>
 
 namespace amrex {
 
@@ -603,4 +606,94 @@ ClusterList::intersect (const BoxDomain& dom)
     }
 }
 
+void
+MergeDistributedClusters (BoxList& bl, const Vector<IntVect>& tagvec, Real grid_eff,
+                          bool use_new_chop)
+{
+    BL_PROFILE("MergeDistributedClusters()");
+
+    Vector<Box> bxs(bl.begin(), bl.end());
+    amrex::AllGatherBoxes(bxs);
+
+    bl.clear();
+    if (bxs.empty()) {
+        return;
+    }
+
+    BoxArray ba(&bxs[0], bxs.size());
+    ba.removeOverlap(false);
+    AMREX_ASSERT(ba.isDisjoint());
+    const int npieces = ba.size();
+
+    //
+    // Count the tags in each piece.  Every tag is in exactly one piece.
+    //
+    Vector<int> piece(tagvec.size(), -1);
+    Vector<long> ntags(npieces, 0);
+    std::vector< std::pair<int,Box> > isects;
+    for (int i = 0, N = tagvec.size(); i < N; ++i)
+    {
+        ba.intersections(Box(tagvec[i],tagvec[i]), isects, true, 0);
+        if (!isects.empty()) {
+            piece[i] = isects[0].first;
+            ++ntags[piece[i]];
+        }
+    }
+    ParallelDescriptor::ReduceLongSum(ntags.data(), npieces);
+
+    //
+    // Keep the efficient pieces and drop the ones without tags.  The
+    // tags of the others are gathered so that every process can chop
+    // them again in the same way.
+    //
+    Vector<int> rechop(npieces, 0);
+    for (int j = 0; j < npieces; ++j)
+    {
+        if (ntags[j] == 0) {
+            continue;
+        }
+        const Box& b = ba[j];
+        if (Real(ntags[j]) >= grid_eff*Real(b.numPts())) {
+            bl.push_back(b);
+        } else {
+            rechop[j] = 1;
+        }
+    }
+
+    if (std::find(rechop.begin(), rechop.end(), 1) != rechop.end())
+    {
+        Vector<Box> tbxs;
+        for (int i = 0, N = tagvec.size(); i < N; ++i) {
+            if (piece[i] >= 0 && rechop[piece[i]]) {
+                tbxs.push_back(Box(tagvec[i],tagvec[i]));
+            }
+        }
+        amrex::AllGatherBoxes(tbxs);
+
+        std::map<int,Vector<IntVect> > ptags;
+        for (const Box& tb : tbxs)
+        {
+            ba.intersections(tb, isects, true, 0);
+            AMREX_ASSERT(!isects.empty());
+            ptags[isects[0].first].push_back(tb.smallEnd());
+        }
+
+        for (auto& kv : ptags)
+        {
+            Vector<IntVect>& pt = kv.second;
+            ClusterList clist(&pt[0], pt.size());
+            if (use_new_chop) {
+                clist.new_chop(grid_eff);
+            } else {
+                clist.chop(grid_eff);
+            }
+            BoxList cbl;
+            clist.boxList(cbl);
+            bl.join(cbl);
+        }
+    }
+
+    bl.simplify();
+}
+
 }
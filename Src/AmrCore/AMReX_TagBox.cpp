@@ -517,34 +517,13 @@ TagBoxArray::collate (Vector<IntVect>& TheGlobalCollateSpace) const
 {
     BL_PROFILE("TagBoxArray::collate()");
 
-    long count = 0;
-
-#ifdef _OPENMP
-#pragma omp parallel reduction(+:count)
-#endif
-    for (MFIter fai(*this); fai.isValid(); ++fai)
-    {
-        count += get(fai).numTags();
-    }
-
     //
     // Local space for holding just those tags we want to gather to the root cpu.
     //
-    Vector<IntVect> TheLocalCollateSpace(count);
+    Vector<IntVect> TheLocalCollateSpace;
+    localCollate(TheLocalCollateSpace);
+    long count = TheLocalCollateSpace.size();
 
-    count = 0;
-
-    // unsafe to do OMP
-    for (MFIter fai(*this); fai.isValid(); ++fai)
-    {
-        count += get(fai).collate(TheLocalCollateSpace,count);
-    }
-
-    if (count > 0)
-    {
-        amrex::RemoveDuplicates(TheLocalCollateSpace);
-	count = TheLocalCollateSpace.size();
-    }
     //
     // The total number of tags system wide that must be collated.
     // This is really just an estimate of the upper bound due to duplicates.
@@ -611,6 +590,37 @@ TagBoxArray::collate (Vector<IntVect>& TheGlobalCollateSpace) const
 #endif
 }
 
+void
+TagBoxArray::localCollate (Vector<IntVect>& TheLocalCollateSpace) const
+{
+    BL_PROFILE("TagBoxArray::localCollate()");
+
+    long count = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:count)
+#endif
+    for (MFIter fai(*this); fai.isValid(); ++fai)
+    {
+        count += get(fai).numTags();
+    }
+
+    TheLocalCollateSpace.resize(count);
+
+    count = 0;
+
+    // unsafe to do OMP
+    for (MFIter fai(*this); fai.isValid(); ++fai)
+    {
+        count += get(fai).collate(TheLocalCollateSpace,count);
+    }
+
+    if (count > 0)
+    {
+        amrex::RemoveDuplicates(TheLocalCollateSpace);
+    }
+}
+
 void
 TagBoxArray::setVal (const BoxList& bl,
                      TagBox::TagVal val)
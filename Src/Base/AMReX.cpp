@@ -433,6 +433,10 @@ amrex::Initialize (int& argc, char**& argv, bool build_parm_parse,
         pp.query("signal_handling", system::signal_handling);
         pp.query("throw_exception", system::throw_exception);
         pp.query("call_addr2line", system::call_addr2line);
+#ifndef AMREX_USE_GPU
+        pp.query("omp_parallel_for", Gpu::in_omp_launch_region);
+        pp.query("omp_parallel_for_min_cells", Gpu::omp_launch_min_cells);
+#endif
 
         if (system::signal_handling)
         {
@@ -1,4 +1,6 @@
 
+#include <numeric>
+
 #include <AMReX_BLassert.H>
 #include <AMReX_BoxArray.H>
 #include <AMReX_ParallelDescriptor.H>
@@ -210,9 +212,14 @@ BARef::updateMemoryUsage_hash (int s)
 {
     if (hash.size() > 0) {
 	long b = sizeof(hash);
-	for (const auto& x: hash) {
-	    b += amrex::gcc_map_node_extra_bytes
-		+ sizeof(IntVect) + amrex::bytesOf(x.second);
+        for (const auto& lev : hash) {
+            for (const auto& h : lev.parts) {
+                b += sizeof(h);
+                for (const auto& x: h) {
+                    b += amrex::gcc_map_node_extra_bytes
+                        + sizeof(IntVect) + amrex::bytesOf(x.second);
+                }
+            }
 	}
 	if (s > 0) {
 	    total_hash_bytes += b;
@@ -224,6 +231,22 @@ BARef::updateMemoryUsage_hash (int s)
 }
 #endif
 
+void
+BARef::addToHash (const Box& b, int i) const
+{
+    // The levels are sorted by size and the box fits into the level of the
+    // box it is part of, or a smaller one.  The bounding box of a smaller
+    // level may not cover it, and the queries only look inside it.
+    for (auto& lev : hash) {
+        if (b.size().allLE(lev.crsn)) {
+            lev.bbox.minBox(amrex::coarsen(b,lev.crsn));
+            lev[amrex::coarsen(b.smallEnd(),lev.crsn)].push_back(i);
+            return;
+        }
+    }
+    amrex::Abort("BARef::addToHash: box too big");
+}
+
 void
 BARef::Initialize ()
 {
@@ -1104,11 +1127,11 @@ BoxArray::intersections (const Box&                         bx,
 {
   // This is called too many times BL_PROFILE("BoxArray::intersections()");
 
-    BARef::HashType& BoxHashMap = getHashMap();
+    const auto& HashLevels = getHashMap();
 
     isects.resize(0);
 
-    if (!BoxHashMap.empty())
+    if (!HashLevels.empty())
     {
         BL_ASSERT(bx.ixType() == ixType());
 
@@ -1120,36 +1143,39 @@ BoxArray::intersections (const Box&                         bx,
 	const IntVect& doihi = getDoiHi();
 
 	gbx.setSmall(glo - doihi).setBig(ghi + doilo);
-        gbx.refine(m_crse_ratio).coarsen(m_ref->crsn);
-	
-        const IntVect& sm = amrex::max(gbx.smallEnd()-1, m_ref->bbox.smallEnd());
-        const IntVect& bg = amrex::min(gbx.bigEnd(),     m_ref->bbox.bigEnd());
-
-        Box cbx(sm,bg);
-        cbx.normalize();
-
-	if (!cbx.intersects(m_ref->bbox)) return;
-
-	auto TheEnd = BoxHashMap.cend();
+        gbx.refine(m_crse_ratio);
 
         bool super_simple = m_simple && m_crse_ratio==1 && m_typ.cellCentered();
         auto& abox = m_ref->m_abox;
 
-        for (IntVect iv = cbx.smallEnd(), End = cbx.bigEnd(); iv <= End; cbx.next(iv))
+        for (const auto& lev : HashLevels)
         {
-            auto it = BoxHashMap.find(iv);
+            const Box& lbx = amrex::coarsen(gbx,lev.crsn);
+
+            const IntVect& sm = amrex::max(lbx.smallEnd()-1, lev.bbox.smallEnd());
+            const IntVect& bg = amrex::min(lbx.bigEnd(),     lev.bbox.bigEnd());
 
-            if (it != TheEnd)
+            Box cbx(sm,bg);
+            cbx.normalize();
+
+            if (!cbx.intersects(lev.bbox)) continue;
+
+            for (IntVect iv = cbx.smallEnd(), End = cbx.bigEnd(); iv <= End; cbx.next(iv))
             {
-                for (const int index : it->second)
-                {
-                    const Box& ibox = super_simple ? abox[index] : (*this)[index];
-                    const Box& isect = bx & amrex::grow(ibox,ng);
+                const std::vector<int>* bucket = lev.find(iv);
 
-                    if (isect.ok())
+                if (bucket)
+                {
+                    for (const int index : *bucket)
                     {
-                        isects.push_back(std::pair<int,Box>(index,isect));
-			if (first_only) return;
+                        const Box& ibox = super_simple ? abox[index] : (*this)[index];
+                        const Box& isect = bx & amrex::grow(ibox,ng);
+
+                        if (isect.ok())
+                        {
+                            isects.push_back(std::pair<int,Box>(index,isect));
+                            if (first_only) return;
+                        }
                     }
                 }
             }
@@ -1174,7 +1200,7 @@ BoxArray::complementIn (BoxList& bl, const Box& bx) const
 
     if (!empty()) 
     {
-	BARef::HashType& BoxHashMap = getHashMap();
+	const auto& HashLevels = getHashMap();
 
 	BL_ASSERT(bx.ixType() == ixType());
 
@@ -1186,17 +1212,7 @@ BoxArray::complementIn (BoxList& bl, const Box& bx) const
 	const IntVect& doihi = getDoiHi();
 
 	gbx.setSmall(glo - doihi).setBig(ghi + doilo);
-        gbx.refine(m_crse_ratio).coarsen(m_ref->crsn);
-	
-        const IntVect& sm = amrex::max(gbx.smallEnd()-1, m_ref->bbox.smallEnd());
-        const IntVect& bg = amrex::min(gbx.bigEnd(),     m_ref->bbox.bigEnd());
-
-        Box cbx(sm,bg);
-        cbx.normalize();
-
-	if (!cbx.intersects(m_ref->bbox)) return;
-
-	auto TheEnd = BoxHashMap.cend();
+        gbx.refine(m_crse_ratio);
 
         BoxList newbl(bl.ixType());
         newbl.reserve(bl.capacity());
@@ -1205,28 +1221,41 @@ BoxArray::complementIn (BoxList& bl, const Box& bx) const
         bool super_simple = m_simple && m_crse_ratio==1 && m_typ.cellCentered();
         auto& abox = m_ref->m_abox;
 
-	for (IntVect iv = cbx.smallEnd(), End = cbx.bigEnd(); 
-	     iv <= End && bl.isNotEmpty(); 
-	     cbx.next(iv))
+        for (const auto& lev : HashLevels)
         {
-            auto it = BoxHashMap.find(iv);
+            const Box& lbx = amrex::coarsen(gbx,lev.crsn);
+
+            const IntVect& sm = amrex::max(lbx.smallEnd()-1, lev.bbox.smallEnd());
+            const IntVect& bg = amrex::min(lbx.bigEnd(),     lev.bbox.bigEnd());
+
+            Box cbx(sm,bg);
+            cbx.normalize();
 
-            if (it != TheEnd)
+            if (!cbx.intersects(lev.bbox)) continue;
+
+            for (IntVect iv = cbx.smallEnd(), End = cbx.bigEnd();
+                 iv <= End && bl.isNotEmpty();
+                 cbx.next(iv))
             {
-                for (const int index : it->second)
-                {
-                    const Box& isect = (super_simple)
-                        ? (bx & abox[index])
-                        : (bx & (*this)[index]);
+                const std::vector<int>* bucket = lev.find(iv);
 
-                    if (isect.ok())
+                if (bucket)
+                {
+                    for (const int index : *bucket)
                     {
-                        newbl.clear();
-                        for (const Box& b : bl) {
-                            amrex::boxDiff(newdiff, b, isect);
-                            newbl.join(newdiff);
+                        const Box& isect = (super_simple)
+                            ? (bx & abox[index])
+                            : (bx & (*this)[index]);
+
+                        if (isect.ok())
+                        {
+                            newbl.clear();
+                            for (const Box& b : bl) {
+                                amrex::boxDiff(newdiff, b, isect);
+                                newbl.join(newdiff);
+                            }
+                            bl.swap(newbl);
                         }
-                        bl.swap(newbl);
                     }
                 }
             }
@@ -1263,8 +1292,6 @@ BoxArray::removeOverlap (bool simplify)
 
     uniqify();
 
-    BARef::HashType& BoxHashMap = m_ref->hash;
-
     const Box EmptyBox;
 
     std::vector< std::pair<int,Box> > isects;
@@ -1298,7 +1325,7 @@ BoxArray::removeOverlap (bool simplify)
                 for (const Box& b : bl_diff)
                 {
                     m_ref->m_abox.push_back(b);
-                    BoxHashMap[amrex::coarsen(b.smallEnd(),m_ref->crsn)].push_back(size()-1);
+                    m_ref->addToHash(b, size()-1);
                 }
             }
         }
@@ -1359,43 +1386,128 @@ BoxArray::getDoiHi () const noexcept
     return m_simple ?           m_typ.ixType() : m_transformer->doiHi();
 }
 
-BARef::HashType&
+const Vector<BARef::HashLevel>&
 BoxArray::getHashMap () const
 {
-    BARef::HashType& BoxHashMap = m_ref->hash;
+    Vector<BARef::HashLevel>& HashLevels = m_ref->hash;
 
-    if (m_ref->HasHashMap()) return BoxHashMap;
+    if (m_ref->HasHashMap()) return HashLevels;
 
 #ifdef _OPENMP
 #pragma omp critical(intersections_lock)
 #endif
     {
-        if (BoxHashMap.empty() && size() > 0)
+        if (HashLevels.empty() && size() > 0)
         {
+            BL_PROFILE("BoxArray::getHashMap()");
+
+            const int N = size();
+            const auto& abox = m_ref->m_abox;
+
+#ifdef _OPENMP
+            const int nthreads = (omp_in_parallel() || N < 4096) ? 1 : omp_get_max_threads();
+#else
+            const int nthreads = 1;
+#endif
             //
-            // Calculate the bounding box & maximum extent of the boxes.
+            // Size class c holds the boxes whose longest side is in (2^(c-1),2^c].
+            // For each thread and class, find the maximum extent and the
+            // bounding box.
             //
-	    IntVect maxext = IntVect::TheUnitVector();
-            Box boundingbox = m_ref->m_abox[0];
-
-	    const int N = size();
-	    for (int i = 0; i < N; ++i)
+            const int nclasses = 32;
+            Vector<int> cls(N);
+            Vector<IntVect> maxext(nthreads*nclasses, IntVect::TheZeroVector());
+            Vector<Box> bbox(nthreads*nclasses);
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nthreads) if (nthreads > 1)
+#endif
             {
-                const Box& bx = m_ref->m_abox[i];
-                maxext = amrex::max(maxext, bx.size());
-                boundingbox.minBox(bx);
+#ifdef _OPENMP
+                const int tid = omp_get_thread_num();
+#else
+                const int tid = 0;
+#endif
+                IntVect* ext = &maxext[tid*nclasses];
+                Box*     bb  = &bbox[tid*nclasses];
+#ifdef _OPENMP
+#pragma omp for
+#endif
+                for (int i = 0; i < N; ++i)
+                {
+                    const Box& bx = abox[i];
+                    if (!bx.ok()) {
+                        cls[i] = -1;  // it cannot intersect anything
+                        continue;
+                    }
+                    const IntVect& sz = bx.size();
+                    int c = 0;
+                    while ((1 << c) < sz.max()) ++c;
+                    cls[i] = c;
+                    ext[c] = amrex::max(ext[c], sz);
+                    if (bb[c].ok()) {
+                        bb[c].minBox(bx);
+                    } else {
+                        bb[c] = bx;
+                    }
+                }
             }
-
-            for (int i = 0; i < N; i++)
+            //
+            // One level per class that has boxes.
+            //
+            Vector<int> class_level(nclasses, -1);
+            for (int c = 0; c < nclasses; ++c)
             {
-                const IntVect& crsnsmlend 
-		    = amrex::coarsen(m_ref->m_abox[i].smallEnd(),maxext);
-                BoxHashMap[crsnsmlend].push_back(i);
+                IntVect ext = IntVect::TheZeroVector();
+                Box bb;
+                for (int t = 0; t < nthreads; ++t) {
+                    const Box& b = bbox[t*nclasses+c];
+                    if (b.ok()) {
+                        ext = amrex::max(ext, maxext[t*nclasses+c]);
+                        if (bb.ok()) {
+                            bb.minBox(b);
+                        } else {
+                            bb = b;
+                        }
+                    }
+                }
+                if (bb.ok()) {
+                    class_level[c] = HashLevels.size();
+                    HashLevels.push_back(BARef::HashLevel());
+                    BARef::HashLevel& lev = HashLevels.back();
+                    lev.crsn = ext;
+                    lev.bbox = bb.coarsen(ext);
+                    lev.bbox.normalize();
+                    lev.parts.resize(nthreads);
+                }
+            }
+            //
+            // Thread t fills part t of every level.  Within a bucket, the
+            // boxes stay in the order of the BoxArray.
+            //
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nthreads) if (nthreads > 1)
+#endif
+            {
+#ifdef _OPENMP
+                const int tid = omp_get_thread_num();
+                const int nt  = omp_get_num_threads();
+#else
+                const int tid = 0;
+                const int nt  = 1;
+#endif
+                for (int p = tid; p < nthreads; p += nt)
+                {
+                    for (int i = 0; i < N; ++i)
+                    {
+                        if (cls[i] < 0) continue;
+                        BARef::HashLevel& lev = HashLevels[class_level[cls[i]]];
+                        const IntVect& key = amrex::coarsen(abox[i].smallEnd(), lev.crsn);
+                        if (BARef::HashLevel::part(key, nthreads) == static_cast<std::size_t>(p)) {
+                            lev.parts[p][key].push_back(i);
+                        }
+                    }
+                }
             }
-
-            m_ref->crsn = maxext;
-            m_ref->bbox =boundingbox.coarsen(maxext);
-            m_ref->bbox.normalize();
 
 #ifdef AMREX_MEM_PROFILING
 	    m_ref->updateMemoryUsage_hash(1);
@@ -1409,7 +1521,7 @@ BoxArray::getHashMap () const
         }
     }
 
-    return BoxHashMap;
+    return HashLevels;
 }
 
 void
@@ -1682,6 +1794,43 @@ bool match (const BoxArray& x, const BoxArray& y)
     }
 }
 
+Vector<int>
+findIdenticalBoxes (const BoxArray& ba, const BoxArray& old_ba)
+{
+    const int N = ba.size();
+    Vector<int> r(N, -1);
+
+    if (old_ba.empty() || ba.ixType() != old_ba.ixType()) return r;
+
+    if (match(ba, old_ba)) {
+        std::iota(r.begin(), r.end(), 0);
+        return r;
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel if (!omp_in_parallel())
+#endif
+    {
+        std::vector< std::pair<int,Box> > isects;
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (int i = 0; i < N; ++i)
+        {
+            const Box& bx = ba[i];
+            old_ba.intersections(bx, isects);
+            for (const auto& is : isects) {
+                if (is.second == bx && old_ba[is.first] == bx) {
+                    r[i] = is.first;
+                    break;
+                }
+            }
+        }
+    }
+
+    return r;
+}
+
 std::ostream&
 operator<< (std::ostream& os, const BoxArray::RefID& id)
 {
@@ -38,6 +38,12 @@ namespace amrex {
     int    sfc_threshold;
     Real   max_efficiency;
     int    node_size;
+    Real   lb_efficiency_gain;
+    Real   lb_amortize;
+    Real   lb_bandwidth;
+    int    node_aware;
+    //! Node of each global rank.  Only set if node_aware.
+    Vector<int> rank_node;
 
 // We default to SFC.
 DistributionMapping::Strategy DistributionMapping::m_Strategy = DistributionMapping::SFC;
@@ -115,6 +121,10 @@ DistributionMapping::Initialize ()
     sfc_threshold    = 0;
     max_efficiency   = 0.9;
     node_size        = 0;
+    lb_efficiency_gain = 0.05;
+    lb_amortize      = 10.0;
+    lb_bandwidth     = 1.e9;
+    node_aware       = 0;
     flag_verbose_mapper = 0;
 
     ParmParse pp("DistributionMapping");
@@ -125,6 +135,14 @@ DistributionMapping::Initialize ()
     pp.query("sfc_threshold",       sfc_threshold);
     pp.query("node_size",           node_size);
     pp.query("verbose_mapper",      flag_verbose_mapper);
+    pp.query("lb_efficiency_gain",  lb_efficiency_gain);
+    pp.query("lb_amortize",         lb_amortize);
+    pp.query("lb_bandwidth",        lb_bandwidth);
+    pp.query("node_aware",          node_aware);
+
+    if (node_aware) {
+        FindNodes();
+    }
 
     std::string theStrategy;
 
@@ -171,6 +189,52 @@ DistributionMapping::Finalize ()
     m_Strategy = SFC;
 
     DistributionMapping::m_BuildMap = 0;
+
+    rank_node.clear();
+}
+
+void
+DistributionMapping::FindNodes ()
+{
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    rank_node.resize(nprocs);
+
+    if (node_size > 0)
+    {
+        // Emulate nodes of node_size consecutive ranks.
+        for (int i = 0; i < nprocs; ++i) {
+            rank_node[i] = i / node_size;
+        }
+    }
+    else
+    {
+#ifdef BL_USE_MPI
+        MPI_Comm node_comm;
+        MPI_Comm_split_type(ParallelDescriptor::Communicator(), MPI_COMM_TYPE_SHARED, 0,
+                            MPI_INFO_NULL, &node_comm);
+        // The lowest rank on a node identifies it.
+        int leader = ParallelDescriptor::MyProc();
+        MPI_Allreduce(MPI_IN_PLACE, &leader, 1, MPI_INT, MPI_MIN, node_comm);
+        MPI_Comm_free(&node_comm);
+        MPI_Allgather(&leader, 1, MPI_INT, rank_node.data(), 1, MPI_INT,
+                      ParallelDescriptor::Communicator());
+
+        std::map<int,int> node_id;
+        for (auto& n : rank_node) {
+            auto r = node_id.insert(std::make_pair(n, static_cast<int>(node_id.size())));
+            n = r.first->second;
+        }
+#else
+        std::fill(rank_node.begin(), rank_node.end(), 0);
+#endif
+    }
+
+    if (verbose) {
+        amrex::Print() << "DistributionMapping: "
+                       << *std::max_element(rank_node.begin(), rank_node.end()) + 1
+                       << " nodes\n";
+    }
 }
 
 void
@@ -1001,6 +1065,46 @@ Distribute (const std::vector<SFCToken>&     tokens,
 #endif
 }
 
+//
+// Cut tokens[begin,end) into contiguous pieces with volumes proportional to
+// share.  Piece i is tokens[cut[i],cut[i+1]).  A token goes to the piece in
+// which the middle of its volume falls.
+//
+static
+void
+SplitCurve (const std::vector<SFCToken>& tokens,
+            int                          begin,
+            int                          end,
+            const std::vector<Real>&     share,
+            std::vector<int>&            cut)
+{
+    const int nbins = share.size();
+
+    cut.assign(nbins+1, end);
+    cut[0] = begin;
+
+    Real vol = 0, stot = 0;
+    for (int k = begin; k < end; ++k) {
+        vol += tokens[k].m_vol;
+    }
+    for (Real s : share) {
+        stot += s;
+    }
+
+    int  b     = 0;
+    Real acc   = 0;
+    Real bound = vol*share[0]/stot;
+    for (int k = begin; k < end; ++k)
+    {
+        const Real mid = acc + 0.5*tokens[k].m_vol;
+        while (b < nbins-1 && mid >= bound) {
+            cut[++b] = k;
+            bound += vol*share[b]/stot;
+        }
+        acc += tokens[k].m_vol;
+    }
+}
+
 void
 DistributionMapping::SFCProcessorMapDoIt (const BoxArray&          boxes,
                                           const std::vector<long>& wgts,
@@ -1067,6 +1171,53 @@ DistributionMapping::SFCProcessorMapDoIt (const BoxArray&          boxes,
     // Put'm in Morton space filling curve order.
     //
     std::sort(tokens.begin(), tokens.end(), SFCToken::Compare());
+
+    if (node_aware)
+    {
+        //
+        // Cut the curve into one piece per node first, so that the boxes of
+        // a node are close together, and then cut each node's piece among
+        // its ranks.  The rest of this function mixes pieces across nodes.
+        //
+        std::map<int,std::vector<int> > node_ranks;
+        for (int i = 0; i < nprocs; ++i) {
+            node_ranks[rank_node[ParallelContext::local_to_global_rank(i)]].push_back(i);
+        }
+
+        std::vector<Real> share;
+        for (const auto& kv : node_ranks) {
+            share.push_back(kv.second.size());
+        }
+
+        std::vector<int> ncut, rcut;
+        SplitCurve(tokens, 0, N, share, ncut);
+
+        Vector<long> rank_wgt(nprocs, 0);
+        int inode = 0;
+        for (const auto& kv : node_ranks)
+        {
+            const std::vector<int>& ranks = kv.second;
+            SplitCurve(tokens, ncut[inode], ncut[inode+1],
+                       std::vector<Real>(ranks.size(), 1.0), rcut);
+            for (int j = 0, M = ranks.size(); j < M; ++j) {
+                for (int k = rcut[j]; k < rcut[j+1]; ++k) {
+                    m_ref->m_pmap[tokens[k].m_box] = ParallelContext::local_to_global_rank(ranks[j]);
+                    rank_wgt[ranks[j]] += wgts[tokens[k].m_box];
+                }
+            }
+            ++inode;
+        }
+
+        if (verbose)
+        {
+            const long max_wgt = *std::max_element(rank_wgt.begin(), rank_wgt.end());
+            const Real sum_wgt = std::accumulate(rank_wgt.begin(), rank_wgt.end(), Real(0.0));
+            amrex::Print() << "Node aware SFC efficiency: " << (sum_wgt/(nprocs*max_wgt))
+                           << " on " << node_ranks.size() << " nodes\n";
+        }
+
+        return;
+    }
     //
     // Split'm up as equitably as possible per team.
     //
@@ -1459,6 +1610,147 @@ DistributionMapping::makeSFC (const MultiFab& weight, bool sort)
     return r;
 }
 
+DistributionMapping
+DistributionMapping::makeSFC (const Vector<Real>& rcost, const BoxArray& ba, bool sort)
+{
+    BL_PROFILE("makeSFC");
+
+    DistributionMapping r;
+
+    if (rcost.empty()) return r;
+
+    Vector<long> cost(rcost.size());
+
+    Real wmax = *std::max_element(rcost.begin(), rcost.end());
+    Real scale = (wmax == 0) ? 1.e9 : 1.e9/wmax;
+
+    for (int i = 0; i < rcost.size(); ++i) {
+        cost[i] = long(rcost[i]*scale) + 1L;
+    }
+
+    int nprocs = ParallelContext::NProcsSub();
+
+    r.SFCProcessorMap(ba, cost, nprocs, sort);
+
+    return r;
+}
+
+DistributionMapping
+DistributionMapping::makeIncremental (const BoxArray& ba, const BoxArray& old_ba,
+                                      const DistributionMapping& old_dm)
+{
+    BL_PROFILE("makeIncremental");
+
+    const int N = ba.size();
+    const Vector<int>& old_index = amrex::findIdenticalBoxes(ba, old_ba);
+
+    Vector<int> pmap(N, -1);
+    Vector<long> load(ParallelDescriptor::NProcs(), 0);
+    std::vector<LIpair> newboxes;
+    for (int i = 0; i < N; ++i) {
+        if (old_index[i] >= 0) {
+            pmap[i] = old_dm[old_index[i]];
+            load[pmap[i]] += ba[i].numPts();
+        } else {
+            newboxes.push_back(LIpair(ba[i].numPts(), i));
+        }
+    }
+
+    Sort(newboxes, true);
+
+    // Min-heap of the loads of the processes in the ParallelContext.
+    std::priority_queue<LIpair, std::vector<LIpair>, LIpairGT> procs;
+    for (int i = 0, nprocs = ParallelContext::NProcsSub(); i < nprocs; ++i) {
+        const int rank = ParallelContext::local_to_global_rank(i);
+        procs.push(LIpair(load[rank], rank));
+    }
+
+    for (const auto& nb : newboxes) {
+        LIpair p = procs.top();
+        procs.pop();
+        pmap[nb.second] = p.second;
+        p.first += nb.first;
+        procs.push(p);
+    }
+
+    if (verbose) {
+        amrex::Print() << "makeIncremental: " << N - newboxes.size() << " of " << N
+                       << " boxes kept their process\n";
+    }
+
+    return DistributionMapping(std::move(pmap));
+}
+
+Real
+DistributionMapping::efficiency (const Vector<Real>& cost) const
+{
+    BL_ASSERT(cost.size() == size());
+
+    // The map holds global ranks, and the boxes go to the processes of
+    // the current communicator.
+    Vector<Real> load(ParallelContext::NProcsSub(), 0.0);
+    for (int i = 0; i < cost.size(); ++i) {
+        load[ParallelContext::global_to_local_rank((*this)[i])] += cost[i];
+    }
+
+    Real lmax = *std::max_element(load.begin(), load.end());
+    Real ltot = std::accumulate(load.begin(), load.end(), Real(0.0));
+
+    return (lmax > 0) ? ltot / (ParallelContext::NProcsSub()*lmax) : 1.0;
+}
+
+DistributionMapping
+DistributionMapping::makeBalanced (const Vector<Real>& rcost, const BoxArray& ba,
+                                   const DistributionMapping& dm, long bytes_per_cell)
+{
+    BL_PROFILE("makeBalanced");
+
+    BL_ASSERT(rcost.size() == ba.size());
+    BL_ASSERT(dm.size() == ba.size());
+
+    if (ba.empty()) return dm;
+
+    // Each process has only measured its own boxes.
+    Vector<Real> cost(rcost.size(), 0.0);
+    const int myproc = ParallelDescriptor::MyProc();
+    for (int i = 0; i < cost.size(); ++i) {
+        if (dm[i] == myproc) cost[i] = rcost[i];
+    }
+    ParallelAllReduce::Sum(cost.data(), cost.size(), ParallelContext::CommunicatorSub());
+
+    DistributionMapping r = (m_Strategy == KNAPSACK) ? makeKnapSack(cost)
+                                                     : makeSFC(cost, ba);
+
+    const Real old_eff = dm.efficiency(cost);
+    const Real new_eff = r.efficiency(cost);
+
+    // The run time is set by the most loaded process.
+    const Real lavg = std::accumulate(cost.begin(), cost.end(), Real(0.0))
+        / ParallelContext::NProcsSub();
+    const Real saved = (lavg/old_eff - lavg/new_eff) * lb_amortize;
+
+    // Each process has to send and receive the boxes it loses and gains.
+    Vector<Real> nbytes(ParallelContext::NProcsSub(), 0.0);
+    for (int i = 0; i < ba.size(); ++i) {
+        if (dm[i] != r[i]) {
+            const Real b = Real(ba[i].numPts()) * bytes_per_cell;
+            nbytes[ParallelContext::global_to_local_rank(dm[i])] += b;
+            nbytes[ParallelContext::global_to_local_rank(r[i])]  += b;
+        }
+    }
+    const Real migration = *std::max_element(nbytes.begin(), nbytes.end()) / lb_bandwidth;
+
+    const bool accept = (new_eff - old_eff >= lb_efficiency_gain) && (saved > migration);
+
+    if (verbose) {
+        amrex::Print() << "makeBalanced: efficiency " << old_eff << " -> " << new_eff
+                       << ", time saved " << saved << ", migration time " << migration
+                       << (accept ? ", rebalancing" : ", keeping the old map") << '\n';
+    }
+
+    return accept ? r : dm;
+}
+
 std::vector<std::vector<int> >
 DistributionMapping::makeSFC (const BoxArray& ba, bool use_box_vol)
 {
@@ -263,6 +263,16 @@ FArrayBox::skipFAB (std::istream& is)
 
 void
 FArrayBox::setFormat (FABio::Format fmt)
+{
+    FABio* fio = newFABio(fmt);
+
+    FArrayBox::format = fmt;
+
+    setFABio(fio);
+}
+
+FABio*
+FArrayBox::newFABio (FABio::Format fmt)
 {
     FABio* fio = 0;
 
@@ -289,13 +299,11 @@ FArrayBox::setFormat (FABio::Format fmt)
         fio = new FABio_binary(FPC::Native32RealDescriptor().clone());
         break;
     default:
-        amrex::ErrorStream() << "FArrayBox::setFormat(): Bad FABio::Format = " << fmt;
+        amrex::ErrorStream() << "FArrayBox::newFABio(): Bad FABio::Format = " << fmt;
         amrex::Abort();
     }
 
-    FArrayBox::format = fmt;
-
-    setFABio(fio);
+    return fio;
 }
 
 void
@@ -24,6 +24,7 @@ namespace amrex {
 // Set default values in Initialize()!!!
 //
 int     FabArrayBase::MaxComp;
+bool    FabArrayBase::fb_persistent = false;
 
 #if defined(AMREX_USE_GPU) && defined(AMREX_USE_GPU_PRAGMA)
 
@@ -111,6 +112,7 @@ FabArrayBase::Initialize ()
     }
 
     pp.query("maxcomp",             FabArrayBase::MaxComp);
+    pp.query("fb_persistent",       FabArrayBase::fb_persistent);
 
     if (MaxComp < 1) {
         MaxComp = 1;
@@ -990,7 +992,27 @@ FabArrayBase::FB::~FB ()
     delete m_LocTags;
     delete m_SndTags;
     delete m_RcvTags;
+#ifdef BL_USE_MPI
+    for (auto& kv : m_plans) {
+        delete kv.second;
+    }
+#endif
+}
+
+#ifdef BL_USE_MPI
+FabArrayBase::FB::PersistentPlan::~PersistentPlan ()
+{
+    BL_ASSERT(!m_busy);
+    for (auto& req : m_send_reqs) {
+        MPI_Request_free(&req);
+    }
+    for (auto& req : m_recv_reqs) {
+        MPI_Request_free(&req);
+    }
+    if (m_the_send_data) amrex::The_FA_Arena()->free(m_the_send_data);
+    if (m_the_recv_data) amrex::The_FA_Arena()->free(m_the_recv_data);
 }
+#endif
 
 void
 FabArrayBase::flushFB (bool no_assertion) const
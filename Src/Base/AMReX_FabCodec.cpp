@@ -0,0 +1,364 @@
+#include <map>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+
+#include <AMReX_FabCodec.H>
+#include <AMReX.H>
+
+namespace amrex {
+
+namespace {
+
+// Every chunk starts with one of these.
+enum ChunkMode : char { RawChunk = 0, ShuffleLZChunk = 1, QuantizedChunk = 2 };
+
+constexpr int  lz_min_match = 4;
+constexpr int  lz_hash_bits = 14;
+constexpr long lz_max_offset = 65535;
+
+inline std::uint32_t read32 (const char* p)
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline int lzHash (std::uint32_t v)
+{
+    return static_cast<int>((v * 2654435761U) >> (32 - lz_hash_bits));
+}
+
+void lzPutLength (long len, Vector<char>& out)
+{
+    while (len >= 255) {
+        out.push_back(static_cast<char>(255));
+        len -= 255;
+    }
+    out.push_back(static_cast<char>(len));
+}
+
+long lzGetLength (const unsigned char* in, long nin, long& ip)
+{
+    long len = 0;
+    unsigned char b;
+    do {
+        if (ip >= nin) amrex::Abort("FabCodec: corrupt LZ chunk");
+        b = in[ip++];
+        len += b;
+    } while (b == 255);
+    return len;
+}
+
+// A sequence is a token, the literals and, except for the last sequence,
+// the match offset.  The token holds the literal length in the high and
+// the match length minus lz_min_match in the low four bits; 15 means that
+// more length bytes follow.
+void lzPutSequence (const char* lit, long nlit, long offset, long nmatch, Vector<char>& out)
+{
+    const long ml = (nmatch > 0) ? nmatch - lz_min_match : 0;
+    const int tlit = static_cast<int>(std::min(nlit, 15L));
+    const int tml  = static_cast<int>(std::min(ml, 15L));
+    out.push_back(static_cast<char>((tlit << 4) | tml));
+    if (nlit >= 15) lzPutLength(nlit-15, out);
+    out.insert(out.end(), lit, lit+nlit);
+    if (nmatch > 0) {
+        out.push_back(static_cast<char>(offset & 0xff));
+        out.push_back(static_cast<char>((offset >> 8) & 0xff));
+        if (ml >= 15) lzPutLength(ml-15, out);
+    }
+}
+
+void shuffle (const Real* data, long n, char* out)
+{
+    const char* in = reinterpret_cast<const char*>(data);
+    const int w = sizeof(Real);
+    for (int b = 0; b < w; ++b) {
+        char* o = out + b*n;
+        for (long i = 0; i < n; ++i) {
+            o[i] = in[i*w+b];
+        }
+    }
+}
+
+void unshuffle (const char* in, long n, Real* data)
+{
+    char* out = reinterpret_cast<char*>(data);
+    const int w = sizeof(Real);
+    for (int b = 0; b < w; ++b) {
+        const char* p = in + b*n;
+        for (long i = 0; i < n; ++i) {
+            out[i*w+b] = p[i];
+        }
+    }
+}
+
+void putRaw (const Real* data, long n, Vector<char>& out)
+{
+    const char* p = reinterpret_cast<const char*>(data);
+    out.push_back(RawChunk);
+    out.insert(out.end(), p, p + n*sizeof(Real));
+}
+
+void compressShuffleLZ (const Real* data, long n, Vector<char>& out)
+{
+    const long nbytes = n*sizeof(Real);
+    Vector<char> shuffled(nbytes);
+    shuffle(data, n, shuffled.dataPtr());
+
+    const long start = out.size();
+    out.push_back(ShuffleLZChunk);
+    FabCodec::lzCompress(shuffled.dataPtr(), nbytes, out);
+    if (static_cast<long>(out.size()) - start > nbytes + 1) {
+        // Incompressible.
+        out.resize(start);
+        putRaw(data, n, out);
+    }
+}
+
+class ShuffleLZCodec
+    : public FabCodec
+{
+public:
+    virtual void compress (const Real* data, long n, Vector<char>& out) const override
+    {
+        compressShuffleLZ(data, n, out);
+    }
+
+    virtual void decompress (const char* in, long nbytes, Real* data, long n) const override;
+};
+
+class QuantizeCodec
+    : public FabCodec
+{
+public:
+    explicit QuantizeCodec (Real tol) : m_tol(tol) {}
+
+    virtual void compress (const Real* data, long n, Vector<char>& out) const override;
+
+    virtual void decompress (const char* in, long nbytes, Real* data, long n) const override;
+
+private:
+    Real m_tol;
+};
+
+void
+decompressChunk (const char* in, long nbytes, Real* data, long n)
+{
+    if (nbytes < 1) amrex::Abort("FabCodec: empty chunk");
+    const char mode = in[0];
+    if (mode == RawChunk) {
+        if (nbytes != 1 + n*static_cast<long>(sizeof(Real))) {
+            amrex::Abort("FabCodec: corrupt raw chunk");
+        }
+        if (n > 0) std::memcpy(data, in+1, n*sizeof(Real));
+    } else if (mode == ShuffleLZChunk) {
+        Vector<char> shuffled(n*sizeof(Real));
+        FabCodec::lzDecompress(in+1, nbytes-1, shuffled.dataPtr(), shuffled.size());
+        unshuffle(shuffled.dataPtr(), n, data);
+    } else {
+        amrex::Abort("FabCodec: unknown chunk type");
+    }
+}
+
+void
+ShuffleLZCodec::decompress (const char* in, long nbytes, Real* data, long n) const
+{
+    decompressChunk(in, nbytes, data, n);
+}
+
+//
+// Quantized chunk: mode, base, step, number of varint bytes, then the LZ
+// compressed zigzag varints of the differences of the grid indices.
+//
+void
+QuantizeCodec::compress (const Real* data, long n, Vector<char>& out) const
+{
+    if (n == 0) {
+        putRaw(data, n, out);
+        return;
+    }
+
+    Real vmin = data[0], vmax = data[0];
+    bool finite = true;
+    for (long i = 0; i < n; ++i) {
+        finite = finite && std::isfinite(data[i]);
+        vmin = std::min(vmin, data[i]);
+        vmax = std::max(vmax, data[i]);
+    }
+
+    // Leave some room for rounding in the reconstruction.
+    Real step = Real(1.99)*m_tol*(vmax-vmin);
+    if (!finite || !(m_tol > 0) || !(vmax-vmin < std::numeric_limits<Real>::max())
+        || (vmax > vmin && !(step > 0))
+        || (vmax > vmin && (vmax-vmin)/step > Real(1.e15)))
+    {
+        compressShuffleLZ(data, n, out);
+        return;
+    }
+    if (vmax == vmin) step = 1.0;
+
+    Vector<char> varints;
+    varints.reserve(n);
+    std::int64_t qprev = 0;
+    for (long i = 0; i < n; ++i) {
+        const std::int64_t q = std::llround((data[i]-vmin)/step);
+        const std::int64_t d = q - qprev;
+        qprev = q;
+        std::uint64_t z = (static_cast<std::uint64_t>(d) << 1) ^ static_cast<std::uint64_t>(d >> 63);
+        while (z >= 0x80) {
+            varints.push_back(static_cast<char>((z & 0x7f) | 0x80));
+            z >>= 7;
+        }
+        varints.push_back(static_cast<char>(z));
+    }
+
+    const std::int64_t nvar = varints.size();
+    out.push_back(QuantizedChunk);
+    const char* p = reinterpret_cast<const char*>(&vmin);
+    out.insert(out.end(), p, p+sizeof(Real));
+    p = reinterpret_cast<const char*>(&step);
+    out.insert(out.end(), p, p+sizeof(Real));
+    p = reinterpret_cast<const char*>(&nvar);
+    out.insert(out.end(), p, p+sizeof(nvar));
+    FabCodec::lzCompress(varints.dataPtr(), nvar, out);
+}
+
+void
+QuantizeCodec::decompress (const char* in, long nbytes, Real* data, long n) const
+{
+    if (nbytes < 1 || in[0] != QuantizedChunk) {
+        decompressChunk(in, nbytes, data, n);
+        return;
+    }
+
+    const long hdrbytes = 1 + 2*sizeof(Real) + sizeof(std::int64_t);
+    if (nbytes < hdrbytes) amrex::Abort("FabCodec: corrupt quantized chunk");
+    Real base, step;
+    std::int64_t nvar;
+    std::memcpy(&base, in+1, sizeof(Real));
+    std::memcpy(&step, in+1+sizeof(Real), sizeof(Real));
+    std::memcpy(&nvar, in+1+2*sizeof(Real), sizeof(nvar));
+
+    Vector<char> varints(nvar);
+    FabCodec::lzDecompress(in+hdrbytes, nbytes-hdrbytes, varints.dataPtr(), nvar);
+
+    const unsigned char* v = reinterpret_cast<const unsigned char*>(varints.dataPtr());
+    long iv = 0;
+    std::int64_t q = 0;
+    for (long i = 0; i < n; ++i) {
+        std::uint64_t z = 0;
+        int shift = 0;
+        unsigned char b;
+        do {
+            if (iv >= nvar) amrex::Abort("FabCodec: corrupt quantized chunk");
+            b = v[iv++];
+            z |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+            shift += 7;
+        } while (b & 0x80);
+        const std::int64_t d = static_cast<std::int64_t>(z >> 1) ^ -static_cast<std::int64_t>(z & 1);
+        q += d;
+        data[i] = base + q*step;
+    }
+}
+
+std::map<std::string,FabCodec::Factory>&
+theRegistry ()
+{
+    static std::map<std::string,FabCodec::Factory> registry {
+        {"shuffle_lz", [] (Real) -> FabCodec* { return new ShuffleLZCodec; }},
+        {"quantize",   [] (Real tol) -> FabCodec* { return new QuantizeCodec(tol); }}
+    };
+    return registry;
+}
+
+}
+
+void
+FabCodec::Register (const std::string& name, Factory f)
+{
+    theRegistry()[name] = f;
+}
+
+FabCodec*
+FabCodec::Create (const std::string& name, Real param)
+{
+    auto& registry = theRegistry();
+    auto it = registry.find(name);
+    if (it == registry.end()) {
+        amrex::Abort("FabCodec::Create: unknown codec " + name);
+    }
+    return it->second(param);
+}
+
+void
+FabCodec::lzCompress (const char* in, long n, Vector<char>& out)
+{
+    Vector<long> table(1 << lz_hash_bits, -1);
+
+    long ip = 0, anchor = 0;
+    while (ip + lz_min_match <= n)
+    {
+        const std::uint32_t seq = read32(in+ip);
+        const int h = lzHash(seq);
+        const long ref = table[h];
+        table[h] = ip;
+        if (ref >= 0 && ip - ref <= lz_max_offset && read32(in+ref) == seq)
+        {
+            long len = lz_min_match;
+            while (ip + len < n && in[ref+len] == in[ip+len]) {
+                ++len;
+            }
+            lzPutSequence(in+anchor, ip-anchor, ip-ref, len, out);
+            ip += len;
+            anchor = ip;
+        }
+        else
+        {
+            ++ip;
+        }
+    }
+    lzPutSequence(in+anchor, n-anchor, 0, 0, out);
+}
+
+void
+FabCodec::lzDecompress (const char* cin, long nin, char* out, long n)
+{
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(cin);
+    long ip = 0, op = 0;
+    while (ip < nin)
+    {
+        const unsigned char token = in[ip++];
+        long nlit = token >> 4;
+        if (nlit == 15) nlit += lzGetLength(in, nin, ip);
+        if (ip + nlit > nin || op + nlit > n) {
+            amrex::Abort("FabCodec: corrupt LZ chunk");
+        }
+        std::memcpy(out+op, in+ip, nlit);
+        ip += nlit;
+        op += nlit;
+
+        if (ip == nin) break; // the last sequence has no match
+
+        if (ip + 2 > nin) amrex::Abort("FabCodec: corrupt LZ chunk");
+        const long offset = in[ip] | (long(in[ip+1]) << 8);
+        ip += 2;
+        long nmatch = token & 15;
+        if (nmatch == 15) nmatch += lzGetLength(in, nin, ip);
+        nmatch += lz_min_match;
+        if (offset == 0 || offset > op || op + nmatch > n) {
+            amrex::Abort("FabCodec: corrupt LZ chunk");
+        }
+        // The match may overlap the output, so copy byte by byte.
+        const char* src = out + op - offset;
+        for (long i = 0; i < nmatch; ++i) {
+            out[op+i] = src[i];
+        }
+        op += nmatch;
+    }
+    if (op != n) amrex::Abort("FabCodec: corrupt LZ chunk");
+}
+
+}
@@ -18,6 +18,9 @@ ScopedDefaultStream::~ScopedDefaultStream ()
     Device::setStream(m_prev_stream);
 }
 
+#else
+bool in_omp_launch_region = false;
+long omp_launch_min_cells = 4096;
 #endif
 
 }
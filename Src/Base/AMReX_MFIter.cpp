@@ -140,6 +140,7 @@ MFIter::MFIter (const BoxArray& ba, const DistributionMapping& dm, const MFItInf
     dynamic(false),
 #endif
     device_sync(info.device_sync),
+    m_cost(info.cost),
     index_map(nullptr),
     local_index_map(nullptr),
     tile_array(nullptr),
@@ -170,6 +171,7 @@ MFIter::MFIter (const FabArrayBase& fabarray_, const MFItInfo& info)
     dynamic(false),
 #endif
     device_sync(info.device_sync),
+    m_cost(info.cost),
     index_map(nullptr),
     local_index_map(nullptr),
     tile_array(nullptr),
@@ -191,6 +193,9 @@ MFIter::MFIter (const FabArrayBase& fabarray_, const MFItInfo& info)
 
 MFIter::~MFIter ()
 {
+    // The loop was left early.
+    if (m_cost && isValid()) recordCost();
+
 #ifdef BL_USE_TEAM
     if ( ! (flags & NoTeamBarrier) )
 	ParallelDescriptor::MyTeam().MemoryBarrier();
@@ -307,6 +312,8 @@ MFIter::Initialize ()
 
 	currentIndex = beginIndex;
 
+        if (m_cost) m_cost_t0 = amrex::second();
+
 #ifdef AMREX_USE_GPU
 	Gpu::Device::setStreamIndex((streams > 0) ? currentIndex%streams : -1);
         Gpu::resetNumCallbacks();
@@ -465,6 +472,8 @@ MFIter::grownnodaltilebox (int dir, IntVect const& a_ng) const noexcept
 void
 MFIter::operator++ () noexcept
 {
+    if (m_cost) recordCost();
+
 #ifdef _OPENMP
     if (dynamic)
     {
@@ -511,6 +520,24 @@ MFIter::operator++ () noexcept
     }
 }
 
+void
+MFIter::recordCost () noexcept
+{
+#ifdef AMREX_USE_GPU
+    // Otherwise we would only time the kernel launches.
+    Gpu::synchronize();
+#endif
+    const double t = amrex::second();
+    Real& c = m_cost[index()];
+    const Real dt = t - m_cost_t0;
+#ifdef _OPENMP
+    // Tiles of the same box may be worked on by different threads.
+#pragma omp atomic
+#endif
+    c += dt;
+    m_cost_t0 = t;
+}
+
 #ifdef AMREX_USE_GPU
 Real*
 MFIter::add_reduce_value(Real* val, MFReducer r)
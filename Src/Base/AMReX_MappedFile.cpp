@@ -0,0 +1,87 @@
+#include <map>
+#include <mutex>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <AMReX_MappedFile.H>
+#include <AMReX.H>
+#include <AMReX_Utility.H>
+
+namespace amrex {
+
+namespace {
+    std::mutex cache_mutex;
+    std::map<std::string, std::shared_ptr<MappedFile> > cache;
+}
+
+MappedFile::MappedFile (const std::string& name)
+{
+    int fd = ::open(name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        amrex::FileOpenFailed(name);
+    }
+
+    struct stat sb;
+    if (::fstat(fd, &sb) != 0) {
+        ::close(fd);
+        amrex::Abort("MappedFile: fstat failed for " + name);
+    }
+    m_size = sb.st_size;
+    m_mtime = sb.st_mtime;
+
+    if (m_size > 0) {
+        void* p = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            amrex::Abort("MappedFile: mmap failed for " + name);
+        }
+        m_data = static_cast<char*>(p);
+    }
+
+    // The mapping stays valid after the descriptor is closed.
+    ::close(fd);
+}
+
+MappedFile::~MappedFile ()
+{
+    if (m_data) {
+        ::munmap(m_data, m_size);
+    }
+}
+
+std::shared_ptr<MappedFile>
+MappedFile::Get (const std::string& name)
+{
+    struct stat sb;
+    const bool exists = (::stat(name.c_str(), &sb) == 0);
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+
+    auto it = cache.find(name);
+    if (it != cache.end())
+    {
+        const MappedFile& mf = *(it->second);
+        if (exists && static_cast<std::size_t>(sb.st_size) == mf.m_size
+                   && static_cast<long>(sb.st_mtime) == mf.m_mtime)
+        {
+            return it->second;
+        }
+        cache.erase(it);
+    }
+
+    std::shared_ptr<MappedFile> p(new MappedFile(name));
+    cache[name] = p;
+    return p;
+}
+
+void
+MappedFile::ClearCache ()
+{
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    cache.clear();
+}
+
+}
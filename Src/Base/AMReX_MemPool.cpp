@@ -11,6 +11,7 @@
 #include <cstdint>
 
 #include <AMReX_CArena.H>
+#include <AMReX_SArena.H>
 #include <AMReX_MemPool.H>
 #include <AMReX_Vector.H>
 
@@ -29,6 +30,8 @@ using namespace amrex;
 namespace
 {
     static Vector<std::unique_ptr<CArena> > the_memory_pool;
+    static std::unique_ptr<SArena> the_sarena;
+    static int use_size_classes = 0;
 #if defined(AMREX_TESTING) || defined(AMREX_DEBUG)
     static int init_snan = 1;
 #else
@@ -47,6 +50,12 @@ void amrex_mempool_init ()
 
         ParmParse pp("fab");
 	pp.query("init_snan", init_snan);
+	pp.query("mempool_size_classes", use_size_classes);
+
+#ifdef USE_PERILLA_PTHREADS
+        // Perilla worker threads do not have unique OpenMP thread numbers.
+        use_size_classes = 0;
+#endif
 
 	int nthreads = 1;
 
@@ -64,9 +73,13 @@ void amrex_mempool_init ()
 #endif
 #endif
 
-	the_memory_pool.resize(nthreads);
-	for (int i=0; i<nthreads; ++i) {
-	    the_memory_pool[i].reset(new CArena);
+	if (use_size_classes) {
+	    the_sarena.reset(new SArena);
+	} else {
+	    the_memory_pool.resize(nthreads);
+	    for (int i=0; i<nthreads; ++i) {
+		the_memory_pool[i].reset(new CArena);
+	    }
 	}
 #ifdef _OPENMP
 #pragma omp parallel num_threads(nthreads)
@@ -94,10 +107,13 @@ void amrex_mempool_finalize ()
 {
     initialized = false;
     the_memory_pool.clear();
+    the_sarena.reset();
 }
 
 void* amrex_mempool_alloc (size_t nbytes)
 {
+  if (the_sarena) return the_sarena->alloc(nbytes);
+
   int tid=0;
 
 #ifdef _OPENMP
@@ -116,6 +132,11 @@ void* amrex_mempool_alloc (size_t nbytes)
 
 void amrex_mempool_free (void* p) 
 {
+  if (the_sarena) {
+      the_sarena->free(p);
+      return;
+  }
+
   int tid=0;
 
 #ifdef _OPENMP
@@ -135,6 +156,12 @@ void amrex_mempool_free (void* p)
 
 void amrex_mempool_get_stats (int& mp_min, int& mp_max, int& mp_tot) // min, max & tot in MB
 {
+  if (the_sarena) {
+      // The size-class pool is shared by all threads.
+      mp_min = mp_max = mp_tot = the_sarena->heap_space_used()/(1024*1024);
+      return;
+  }
+
   size_t hsu_min=std::numeric_limits<size_t>::max();
   size_t hsu_max=0;
   size_t hsu_tot=0;
@@ -955,12 +955,7 @@ ParallelDescriptor::util::DoAllReduceReal (Real&  r,
     else
 #endif
     {
-	BL_MPI_REQUIRE( MPI_Allreduce(&r,
-				      &recv,
-				      1,
-				      Mpi_typemap<Real>::type(),
-				      op,
-				      Communicator()) );
+	recv = ReduceFuture<Real>(Vector<Real>{r}, op, Communicator()).get();
     }
     BL_COMM_PROFILE_ALLREDUCE(BLProfiler::AllReduceR, sizeof(Real), false);
     r = recv;
@@ -998,12 +993,7 @@ ParallelDescriptor::util::DoAllReduceReal (Real*  r,
     else
 #endif
     {
-	BL_MPI_REQUIRE( MPI_Allreduce(r,
-				      recv.dataPtr(),
-				      cnt,
-				      Mpi_typemap<Real>::type(),
-				      op,
-				      Communicator()) );
+	ReduceFuture<Real>(Vector<Real>(r, r+cnt), op, Communicator()).getAll(recv.dataPtr());
     }
     BL_COMM_PROFILE_ALLREDUCE(BLProfiler::AllReduceR, cnt * sizeof(Real), false);
     for (int i = 0; i < cnt; i++)
@@ -1136,12 +1126,7 @@ ParallelDescriptor::util::DoAllReduceLong (long&  r,
     else
 #endif
     {
-	BL_MPI_REQUIRE( MPI_Allreduce(&r,
-				      &recv,
-				      1,
-				      MPI_LONG,
-				      op,
-				      Communicator()) );
+	recv = ReduceFuture<long>(Vector<long>{r}, op, Communicator()).get();
     }
     BL_COMM_PROFILE_ALLREDUCE(BLProfiler::AllReduceL, sizeof(long), false);
     r = recv;
@@ -1179,12 +1164,7 @@ ParallelDescriptor::util::DoAllReduceLong (long*  r,
     else
 #endif
     {
-	BL_MPI_REQUIRE( MPI_Allreduce(r,
-				      recv.dataPtr(),
-				      cnt,
-				      MPI_LONG,
-				      op,
-				      Communicator()) );
+	ReduceFuture<long>(Vector<long>(r, r+cnt), op, Communicator()).getAll(recv.dataPtr());
     }
     BL_COMM_PROFILE_ALLREDUCE(BLProfiler::AllReduceL, cnt * sizeof(long), false);
     for (int i = 0; i < cnt; i++)
@@ -1317,12 +1297,7 @@ ParallelDescriptor::util::DoAllReduceInt (int&   r,
     else
 #endif
     {
-	BL_MPI_REQUIRE( MPI_Allreduce(&r,
-				      &recv,
-				      1,
-				      MPI_INT,
-				      op,
-				      Communicator()));
+	recv = ReduceFuture<int>(Vector<int>{r}, op, Communicator()).get();
     }
     BL_COMM_PROFILE_ALLREDUCE(BLProfiler::AllReduceI, sizeof(int), false);
     r = recv;
@@ -1360,12 +1335,7 @@ ParallelDescriptor::util::DoAllReduceInt (int*   r,
     else
 #endif
     {
-	BL_MPI_REQUIRE( MPI_Allreduce(r,
-				      recv.dataPtr(),
-				      cnt,
-				      MPI_INT,
-				      op,
-				      Communicator()));
+	ReduceFuture<int>(Vector<int>(r, r+cnt), op, Communicator()).getAll(recv.dataPtr());
     }
     BL_COMM_PROFILE_ALLREDUCE(BLProfiler::AllReduceI, cnt * sizeof(int), false);
     for (int i = 0; i < cnt; i++)
@@ -1659,6 +1629,101 @@ ParallelDescriptor::Bcast(void *buf,
 }
 
 
+namespace
+{
+    template <class T>
+    ParallelDescriptor::ReduceFuture<T>
+    IAllReduce (T const* r, int cnt, MPI_Op op, MPI_Comm comm)
+    {
+#ifdef BL_LAZY
+        Lazy::EvalReduction();
+#endif
+        BL_PROFILE_S("ParallelDescriptor::IAllReduce()");
+        return ParallelDescriptor::ReduceFuture<T>(Vector<T>(r, r+cnt), op, comm);
+    }
+
+    // The buffer of the combined reduction is one element of a contiguous
+    // type holding the number of sums followed by the sums and the values
+    // to be maximized.  Because it is a single element, MPI cannot split it.
+    void
+    sum_max_op (void* invec, void* inoutvec, int* len, MPI_Datatype* dtype)
+    {
+        int nbytes;
+        MPI_Type_size(*dtype, &nbytes);
+        const int n = nbytes / sizeof(Real);
+        for (int l = 0; l < *len; ++l)
+        {
+            Real const* in = static_cast<Real const*>(invec) + l*n;
+            Real* inout = static_cast<Real*>(inoutvec) + l*n;
+            const int nsum = static_cast<int>(in[0]);
+            for (int i = 1; i <= nsum; ++i) {
+                inout[i] += in[i];
+            }
+            for (int i = nsum+1; i < n; ++i) {
+                inout[i] = std::max(inout[i], in[i]);
+            }
+        }
+    }
+}
+
+#define AMREX_PD_IREDUCE(NAME,T,OP)                                      \
+    ParallelDescriptor::ReduceFuture<T>                                 \
+    ParallelDescriptor::NAME (T r, MPI_Comm comm)                       \
+    { return IAllReduce<T>(&r, 1, OP, comm); }                          \
+    ParallelDescriptor::ReduceFuture<T>                                 \
+    ParallelDescriptor::NAME (T const* r, int cnt, MPI_Comm comm)       \
+    { return IAllReduce<T>(r, cnt, OP, comm); }
+
+AMREX_PD_IREDUCE(IReduceRealSum, Real, MPI_SUM)
+AMREX_PD_IREDUCE(IReduceRealMax, Real, MPI_MAX)
+AMREX_PD_IREDUCE(IReduceRealMin, Real, MPI_MIN)
+AMREX_PD_IREDUCE(IReduceLongSum, long, MPI_SUM)
+AMREX_PD_IREDUCE(IReduceLongMax, long, MPI_MAX)
+AMREX_PD_IREDUCE(IReduceLongMin, long, MPI_MIN)
+AMREX_PD_IREDUCE(IReduceIntSum,  int,  MPI_SUM)
+AMREX_PD_IREDUCE(IReduceIntMax,  int,  MPI_MAX)
+AMREX_PD_IREDUCE(IReduceIntMin,  int,  MPI_MIN)
+
+#undef AMREX_PD_IREDUCE
+
+ParallelDescriptor::ReduceFuture<Real>
+ParallelDescriptor::IReduceRealSumMaxMin (Real const* sums, int nsum,
+                                          Real const* maxs, int nmax,
+                                          Real const* mins, int nmin,
+                                          MPI_Comm comm)
+{
+    if (nmax == 0 && nmin == 0) {
+        return IAllReduce<Real>(sums, nsum, MPI_SUM, comm);
+    } else if (nsum == 0 && nmin == 0) {
+        return IAllReduce<Real>(maxs, nmax, MPI_MAX, comm);
+    } else if (nsum == 0 && nmax == 0) {
+        return IAllReduce<Real>(mins, nmin, MPI_MIN, comm);
+    }
+
+#ifdef BL_LAZY
+    Lazy::EvalReduction();
+#endif
+    BL_PROFILE_S("ParallelDescriptor::IReduceRealSumMaxMin()");
+
+    // Minima are reduced as maxima of the negated values.
+    const int n = 1 + nsum + nmax + nmin;
+    Vector<Real> v(n);
+    v[0] = nsum;
+    std::copy(sums, sums+nsum, v.begin()+1);
+    std::copy(maxs, maxs+nmax, v.begin()+1+nsum);
+    for (int i = 0; i < nmin; ++i) {
+        v[1+nsum+nmax+i] = -mins[i];
+    }
+
+    MPI_Datatype dtype;
+    BL_MPI_REQUIRE( MPI_Type_contiguous(n, Mpi_typemap<Real>::type(), &dtype) );
+    BL_MPI_REQUIRE( MPI_Type_commit(&dtype) );
+    MPI_Op op;
+    BL_MPI_REQUIRE( MPI_Op_create(sum_max_op, 1, &op) );
+
+    return ReduceFuture<Real>(std::move(v), 1, nsum+nmax, dtype, op, comm);
+}
+
 #else /*!BL_USE_MPI*/
 
 void
@@ -1836,6 +1901,38 @@ ParallelDescriptor::Waitsome (Vector<MPI_Request>& reqs,
                               Vector<MPI_Status>&  status)
 {}
 
+#define AMREX_PD_IREDUCE(NAME,T)                                         \
+    ParallelDescriptor::ReduceFuture<T>                                 \
+    ParallelDescriptor::NAME (T r, MPI_Comm comm)                       \
+    { return ReduceFuture<T>(Vector<T>{r}, 0, comm); }                  \
+    ParallelDescriptor::ReduceFuture<T>                                 \
+    ParallelDescriptor::NAME (T const* r, int cnt, MPI_Comm comm)       \
+    { return ReduceFuture<T>(Vector<T>(r, r+cnt), 0, comm); }
+
+AMREX_PD_IREDUCE(IReduceRealSum, Real)
+AMREX_PD_IREDUCE(IReduceRealMax, Real)
+AMREX_PD_IREDUCE(IReduceRealMin, Real)
+AMREX_PD_IREDUCE(IReduceLongSum, long)
+AMREX_PD_IREDUCE(IReduceLongMax, long)
+AMREX_PD_IREDUCE(IReduceLongMin, long)
+AMREX_PD_IREDUCE(IReduceIntSum,  int)
+AMREX_PD_IREDUCE(IReduceIntMax,  int)
+AMREX_PD_IREDUCE(IReduceIntMin,  int)
+
+#undef AMREX_PD_IREDUCE
+
+ParallelDescriptor::ReduceFuture<Real>
+ParallelDescriptor::IReduceRealSumMaxMin (Real const* sums, int nsum,
+                                          Real const* maxs, int nmax,
+                                          Real const* mins, int nmin,
+                                          MPI_Comm comm)
+{
+    Vector<Real> v(sums, sums+nsum);
+    v.insert(v.end(), maxs, maxs+nmax);
+    v.insert(v.end(), mins, mins+nmin);
+    return ReduceFuture<Real>(std::move(v), 0, comm);
+}
+
 #endif
 
 BL_FORT_PROC_DECL(BL_PD_BARRIER,bl_pd_barrier)()
@@ -135,8 +135,17 @@ PlotFileDataImpl::get (int level, std::string const& varname) noexcept
         for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
             int gid = mfi.index();
             FArrayBox& dstfab = mf[mfi];
-            std::unique_ptr<FArrayBox> srcfab(m_vismf[level]->readFAB(gid, icomp));
-            dstfab.copy(*srcfab);
+            std::shared_ptr<FArrayBox> srcfab;
+            if (VisMF::GetUseMmap()) {
+                // Alias the mapped file; only the pages of icomp are read.
+                srcfab = m_vismf[level]->mapFAB(gid);
+            }
+            if (srcfab) {
+                dstfab.copy(*srcfab, icomp, 0, 1);
+            } else {
+                srcfab.reset(m_vismf[level]->readFAB(gid, icomp));
+                dstfab.copy(*srcfab);
+            }
         }
     }
     return mf;
@@ -11,6 +11,69 @@
 
 namespace amrex {
 
+namespace {
+
+// Build the plotfile directories and write the plotfile Header.
+void
+WritePlotfileDirsAndHeader (const std::string& plotfilename, int nlevels,
+                            const Vector<const MultiFab*>& mf,
+                            const Vector<std::string>& varnames,
+                            const Vector<Geometry>& geom, Real time, const Vector<int>& level_steps,
+                            const Vector<IntVect>& ref_ratio,
+                            const std::string &versionName,
+                            const std::string &levelPrefix,
+                            const std::string &mfPrefix,
+                            const Vector<std::string>& extra_dirs)
+{
+    bool callBarrier(false);
+    PreBuildDirectorHierarchy(plotfilename, levelPrefix, nlevels, callBarrier);
+    if (!extra_dirs.empty()) {
+        for (const auto& d : extra_dirs) {
+            const std::string ed = plotfilename+"/"+d;
+            amrex::PreBuildDirectorHierarchy(ed, levelPrefix, nlevels, callBarrier);
+        }
+    }
+    ParallelDescriptor::Barrier();
+
+    if (ParallelDescriptor::IOProcessor()) {
+      VisMF::IO_Buffer io_buffer(VisMF::IO_Buffer_Size);
+      std::string HeaderFileName(plotfilename + "/Header");
+      std::ofstream HeaderFile;
+      HeaderFile.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
+      HeaderFile.open(HeaderFileName.c_str(), std::ofstream::out   |
+	                                      std::ofstream::trunc |
+                                              std::ofstream::binary);
+      if( ! HeaderFile.good()) {
+        FileOpenFailed(HeaderFileName);
+      }
+
+      Vector<BoxArray> boxArrays(nlevels);
+      for(int level(0); level < boxArrays.size(); ++level) {
+	boxArrays[level] = mf[level]->boxArray();
+      }
+
+      WriteGenericPlotfileHeader(HeaderFile, nlevels, boxArrays, varnames,
+                                 geom, time, level_steps, ref_ratio, versionName, levelPrefix, mfPrefix);
+    }
+}
+
+// Plotfiles have no ghost cells.  Returns mf itself or a copy of it
+// without ghost cells held in tmp.
+const MultiFab*
+NoGhostData (const MultiFab& mf, std::unique_ptr<MultiFab>& tmp)
+{
+    if (mf.nGrow() > 0) {
+        tmp.reset(new MultiFab(mf.boxArray(), mf.DistributionMap(), mf.nComp(), 0,
+                               MFInfo(), mf.Factory()));
+        MultiFab::Copy(*tmp, mf, 0, 0, mf.nComp(), 0);
+        return tmp.get();
+    } else {
+        return &mf;
+    }
+}
+
+}
+
 std::string LevelPath (int level, const std::string &levelPrefix)
 {
     return Concatenate(levelPrefix, level, 1);  // e.g., Level_5
@@ -172,52 +235,14 @@ WriteMultiLevelPlotfile (const std::string& plotfilename, int nlevels,
 //    int saveNFiles(VisMF::GetNOutFiles());
 //    VisMF::SetNOutFiles(std::max(1024,saveNFiles));
 
-    bool callBarrier(false);
-    PreBuildDirectorHierarchy(plotfilename, levelPrefix, nlevels, callBarrier);
-    if (!extra_dirs.empty()) {
-        for (const auto& d : extra_dirs) {
-            const std::string ed = plotfilename+"/"+d;
-            amrex::PreBuildDirectorHierarchy(ed, levelPrefix, nlevels, callBarrier);
-        }
-    }
-    ParallelDescriptor::Barrier();
-
-    if (ParallelDescriptor::IOProcessor()) {
-      VisMF::IO_Buffer io_buffer(VisMF::IO_Buffer_Size);
-      std::string HeaderFileName(plotfilename + "/Header");
-      std::ofstream HeaderFile;
-      HeaderFile.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
-      HeaderFile.open(HeaderFileName.c_str(), std::ofstream::out   |
-	                                      std::ofstream::trunc |
-                                              std::ofstream::binary);
-      if( ! HeaderFile.good()) {
-        FileOpenFailed(HeaderFileName);
-      }
-
-      Vector<BoxArray> boxArrays(nlevels);
-      for(int level(0); level < boxArrays.size(); ++level) {
-	boxArrays[level] = mf[level]->boxArray();
-      }
-
-      WriteGenericPlotfileHeader(HeaderFile, nlevels, boxArrays, varnames,
-                                 geom, time, level_steps, ref_ratio, versionName, levelPrefix, mfPrefix);
-    }
-
+    WritePlotfileDirsAndHeader(plotfilename, nlevels, mf, varnames, geom, time,
+                               level_steps, ref_ratio, versionName, levelPrefix, mfPrefix,
+                               extra_dirs);
 
     for (int level = 0; level <= finest_level; ++level)
     {
-        const MultiFab* data;
         std::unique_ptr<MultiFab> mf_tmp;
-        if (mf[level]->nGrow() > 0) {
-            mf_tmp.reset(new MultiFab(mf[level]->boxArray(),
-                                      mf[level]->DistributionMap(),
-                                      mf[level]->nComp(), 0, MFInfo(),
-                                      mf[level]->Factory()));
-            MultiFab::Copy(*mf_tmp, *mf[level], 0, 0, mf[level]->nComp(), 0);
-            data = mf_tmp.get();
-        } else {
-            data = mf[level];
-        }
+        const MultiFab* data = NoGhostData(*mf[level], mf_tmp);
 	VisMF::Write(*data, MultiFabFileFullPrefix(level, plotfilename, levelPrefix, mfPrefix));
     }
 
@@ -341,6 +366,176 @@ WriteSingleLevelPlotfile (const std::string& plotfilename,
                             level_steps, ref_ratio, versionName, levelPrefix, mfPrefix, extra_dirs);
 }
 
+AsyncPlotfileWriter::AsyncPlotfileWriter (int max_in_flight, bool single_precision)
+    : m_max_in_flight(std::max(max_in_flight,1)),
+      m_format(single_precision ? FABio::FAB_NATIVE_32 : FArrayBox::getFormat())
+{
+    m_thread = std::thread(&AsyncPlotfileWriter::drain, this);
+}
+
+AsyncPlotfileWriter::~AsyncPlotfileWriter ()
+{
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_finalize = true;
+    }
+    m_job_cv.notify_one();
+    m_thread.join();
+}
+
+void
+AsyncPlotfileWriter::write (const std::string& plotfilename, int nlevels,
+                            const Vector<const MultiFab*>& mf,
+                            const Vector<std::string>& varnames,
+                            const Vector<Geometry>& geom, Real time,
+                            const Vector<int>& level_steps,
+                            const Vector<IntVect>& ref_ratio,
+                            const std::string &versionName,
+                            const std::string &levelPrefix,
+                            const std::string &mfPrefix,
+                            const Vector<std::string>& extra_dirs)
+{
+    BL_PROFILE("AsyncPlotfileWriter::write()");
+
+    BL_ASSERT(nlevels <= mf.size());
+    BL_ASSERT(nlevels <= geom.size());
+    BL_ASSERT(nlevels <= ref_ratio.size()+1);
+    BL_ASSERT(nlevels <= level_steps.size());
+    BL_ASSERT(mf[0]->nComp() == varnames.size());
+
+    Real t0 = amrex::second();
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done_cv.wait(lock, [this] { return m_in_flight < m_max_in_flight; });
+    }
+    Real t1 = amrex::second();
+    m_t_blocked += t1-t0;
+
+    WritePlotfileDirsAndHeader(plotfilename, nlevels, mf, varnames, geom, time,
+                               level_steps, ref_ratio, versionName, levelPrefix, mfPrefix,
+                               extra_dirs);
+
+    Job job;
+    for (int level = 0; level < nlevels; ++level)
+    {
+        std::unique_ptr<MultiFab> mf_tmp;
+        const MultiFab* data = NoGhostData(*mf[level], mf_tmp);
+        job.push_back(VisMF::SnapshotAsync(*data,
+                                           MultiFabFileFullPrefix(level, plotfilename,
+                                                                  levelPrefix, mfPrefix),
+                                           m_format));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+        ++m_in_flight;
+    }
+    m_job_cv.notify_one();
+
+    m_t_snapshot += amrex::second() - t1;
+}
+
+void
+AsyncPlotfileWriter::wait ()
+{
+    BL_PROFILE("AsyncPlotfileWriter::wait()");
+    Real t0 = amrex::second();
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done_cv.wait(lock, [this] { return m_in_flight == 0; });
+    }
+    m_t_blocked += amrex::second() - t0;
+}
+
+int
+AsyncPlotfileWriter::numInFlight () const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_in_flight;
+}
+
+Real
+AsyncPlotfileWriter::writeTime () const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_t_write;
+}
+
+Real
+AsyncPlotfileWriter::hiddenTime () const
+{
+    return std::max(writeTime() - m_t_blocked, Real(0.0));
+}
+
+void
+AsyncPlotfileWriter::printStats () const
+{
+    int nwritten;
+    long nbytes;
+    Real t[4];
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        nwritten = m_nwritten;
+        nbytes = m_nbytes;
+        t[0] = m_t_write;
+    }
+    t[1] = m_t_snapshot;
+    t[2] = m_t_blocked;
+    t[3] = std::max(t[0] - t[2], Real(0.0));
+
+    ParallelDescriptor::ReduceLongSum(nbytes);
+    ParallelDescriptor::ReduceRealMax(t, 4);
+
+    amrex::Print() << "AsyncPlotfileWriter: " << nwritten << " plotfiles, "
+                   << nbytes << " bytes\n"
+                   << "    snapshot time: " << t[1] << "\n"
+                   << "    write time:    " << t[0] << "\n"
+                   << "    blocked time:  " << t[2] << "\n"
+                   << "    hidden time:   " << t[3];
+    if (t[0] > 0.0) {
+        amrex::Print() << " (" << 100.*t[3]/t[0] << "%)";
+    }
+    amrex::Print() << "\n";
+}
+
+void
+AsyncPlotfileWriter::drain ()
+{
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_job_cv.wait(lock, [this] { return m_finalize || !m_jobs.empty(); });
+            if (m_jobs.empty()) return;
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        // The levels are written in order on every process, so the
+        // hand-offs between processes sharing a file cannot deadlock.
+        Real t0 = amrex::second();
+        int64_t nbytes = 0;
+        for (auto& f : job) {
+            nbytes += f().nbytes;
+        }
+        // Free the staging buffers before the slot is released.
+        job.clear();
+        Real t1 = amrex::second();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_t_write += t1-t0;
+            m_nbytes += nbytes;
+            ++m_nwritten;
+            --m_in_flight;
+        }
+        m_done_cv.notify_all();
+    }
+}
+
 #ifdef AMREX_USE_EB
 void
 EB_WriteSingleLevelPlotfile (const std::string& plotfilename,
@@ -0,0 +1,240 @@
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <limits>
+
+#include <AMReX_SArena.H>
+#include <AMReX_BLassert.H>
+#include <AMReX.H>
+
+namespace amrex {
+
+SArena::SArena (std::size_t max_small_size, std::size_t hunk_size, ArenaInfo info)
+    : m_backing(hunk_size, info),
+      m_shared_misses(0)
+{
+    arena_info = info;
+
+    // Each block carries a header of align_size bytes in front of the
+    // pointer returned to the caller.
+    m_max_order = m_min_order;
+    while ((std::size_t(1) << m_max_order) < max_small_size + align_size) {
+        ++m_max_order;
+    }
+    if (m_max_order > m_max_max_order) {
+        amrex::Abort("SArena: max_small_size too large");
+    }
+
+    for (int c = 0; c < m_nclasses; ++c) {
+        const std::size_t blksize = std::size_t(1) << (c+m_min_order);
+        const std::size_t n = m_magazine_bytes / blksize;
+        m_magazine_size[c] = (n < 2) ? 2 : ((n > 64) ? 64 : static_cast<int>(n));
+    }
+
+    // A num_threads clause may ask for more threads than the default, so
+    // allow for one per processor, or for the thread limit if it was set.
+    // Threads beyond the caches use the depot directly.
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = std::max(omp_get_max_threads(), omp_get_num_procs());
+    const int limit = omp_get_thread_limit();
+    if (limit < std::numeric_limits<int>::max()) {
+        nthreads = std::max(nthreads, limit);
+    }
+#endif
+    m_cache.resize(nthreads);
+}
+
+SArena::~SArena ()
+{
+    // All blocks live in m_backing, which returns its memory to the system.
+}
+
+SArena::ThreadCache*
+SArena::threadCache () noexcept
+{
+#ifdef _OPENMP
+    // Only a single level of active parallelism has unique thread numbers.
+    if (omp_get_active_level() == 1) {
+        const int tid = omp_get_thread_num();
+        if (tid < static_cast<int>(m_cache.size())) {
+            return &m_cache[tid];
+        }
+    }
+#endif
+    return nullptr;
+}
+
+void*
+SArena::alloc (std::size_t nbytes)
+{
+    const std::size_t total = Arena::align(nbytes == 0 ? 1 : nbytes) + align_size;
+
+    char* blk;
+    int order;
+    if (total <= (std::size_t(1) << m_max_order))
+    {
+        order = m_min_order;
+        while ((std::size_t(1) << order) < total) {
+            ++order;
+        }
+        blk = static_cast<char*>(allocBlock(order, threadCache()));
+    }
+    else
+    {
+        order = -1;
+        blk = static_cast<char*>(m_backing.alloc(total));
+    }
+
+    *reinterpret_cast<int*>(blk) = order;
+    return blk + align_size;
+}
+
+void
+SArena::free (void* p)
+{
+    if (p == nullptr) return;
+
+    char* blk = static_cast<char*>(p) - align_size;
+    const int order = *reinterpret_cast<int*>(blk);
+    if (order < 0) {
+        m_backing.free(blk);
+    } else {
+        BL_ASSERT(order >= m_min_order && order <= m_max_order);
+        freeBlock(blk, order, threadCache());
+    }
+}
+
+void*
+SArena::allocBlock (int order, ThreadCache* tc)
+{
+    const int c = order - m_min_order;
+    Depot& depot = m_depot[c];
+
+    if (tc)
+    {
+        Magazine& mag = tc->mag[c];
+        if (mag.empty())
+        {
+            std::unique_lock<std::mutex> lock(depot.mutex);
+            if (depot.full.empty()) {
+                lock.unlock();
+                ++(tc->nmisses);
+                return newBlock(order);
+            }
+            mag.swap(depot.full.back());
+            depot.full.pop_back();
+        }
+        void* blk = mag.back();
+        mag.pop_back();
+        return blk;
+    }
+    else
+    {
+        std::unique_lock<std::mutex> lock(depot.mutex);
+        if (depot.full.empty()) {
+            lock.unlock();
+            ++m_shared_misses;
+            return newBlock(order);
+        }
+        Magazine& mag = depot.full.back();
+        void* blk = mag.back();
+        mag.pop_back();
+        if (mag.empty()) depot.full.pop_back();
+        return blk;
+    }
+}
+
+void
+SArena::freeBlock (void* blk, int order, ThreadCache* tc)
+{
+    const int c = order - m_min_order;
+    const std::size_t magsize = m_magazine_size[c];
+    Depot& depot = m_depot[c];
+
+    if (tc)
+    {
+        Magazine& mag = tc->mag[c];
+        if (mag.size() >= 2*magsize)
+        {
+            // Keep half of the blocks and hand the other half to the depot.
+            Magazine full(mag.end()-magsize, mag.end());
+            mag.resize(mag.size()-magsize);
+
+            Magazine overflow;
+            {
+                std::lock_guard<std::mutex> lock(depot.mutex);
+                if (static_cast<int>(depot.full.size()) < m_max_depot_magazines) {
+                    depot.full.push_back(std::move(full));
+                } else {
+                    overflow.swap(full);
+                }
+            }
+            for (void* p : overflow) {
+                m_backing.free(p);
+            }
+        }
+        else if (mag.capacity() == 0)
+        {
+            mag.reserve(2*magsize);
+        }
+        mag.push_back(blk);
+    }
+    else
+    {
+        std::unique_lock<std::mutex> lock(depot.mutex);
+        if (depot.full.empty() || depot.full.back().size() >= magsize)
+        {
+            if (static_cast<int>(depot.full.size()) >= m_max_depot_magazines) {
+                lock.unlock();
+                m_backing.free(blk);
+                return;
+            }
+            depot.full.push_back(Magazine());
+            depot.full.back().reserve(magsize);
+        }
+        depot.full.back().push_back(blk);
+    }
+}
+
+void*
+SArena::newBlock (int order)
+{
+    return m_backing.alloc(std::size_t(1) << order);
+}
+
+void
+SArena::flush ()
+{
+    for (auto& tc : m_cache) {
+        for (auto& mag : tc.mag) {
+            for (void* p : mag) {
+                m_backing.free(p);
+            }
+            Magazine().swap(mag);
+        }
+    }
+    for (auto& depot : m_depot) {
+        std::lock_guard<std::mutex> lock(depot.mutex);
+        for (auto& mag : depot.full) {
+            for (void* p : mag) {
+                m_backing.free(p);
+            }
+        }
+        depot.full.clear();
+    }
+}
+
+long
+SArena::numMisses () const noexcept
+{
+    long n = m_shared_misses;
+    for (auto const& tc : m_cache) {
+        n += tc.nmisses;
+    }
+    return n;
+}
+
+}
@@ -6,12 +6,17 @@
 #include <iomanip>
 #include <cmath>
 #include <set>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include <AMReX_TinyProfiler.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParallelReduce.H>
 #include <AMReX_Utility.H>
 #include <AMReX_Print.H>
+#include <AMReX_ParmParse.H>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -19,36 +24,139 @@
 
 namespace amrex {
 
-std::vector<std::string>          TinyProfiler::regionstack;
-std::deque<std::tuple<double,double,std::string*> > TinyProfiler::ttstack;
-std::map<std::string,std::map<std::string, TinyProfiler::Stats> > TinyProfiler::statsmap;
+std::vector<int> TinyProfiler::regionstack;
+std::deque<std::vector<int> > TinyProfiler::regionstacks;
+const std::vector<int>* TinyProfiler::current_regions = nullptr;
 double TinyProfiler::t_init = std::numeric_limits<double>::max();
 
+struct TinyProfiler::ThreadData
+{
+    struct Frame
+    {
+        double t0;           //!< wall time when the timer is started
+        double dt_children;  //!< accumulated dt of children
+        int id;
+    };
+
+    struct Event
+    {
+        int id;
+        double t0, t1;
+    };
+
+    int tid = 0;
+    std::vector<Frame> stack;
+    std::vector<std::vector<Stats> > stats;   //!< [region][timer]
+    std::set<int> improperly_nested_timers;
+
+    //! Names seen by this thread.  A const char* is usually a string
+    //! literal, so its address is the key, but the name is checked too.
+    std::unordered_map<const char*, std::pair<int,std::string> > cstr_ids;
+    std::unordered_map<std::string, int> str_ids;
+
+    std::vector<Event> trace;
+    long trace_dropped = 0;
+};
+
 namespace {
-    std::set<std::string> improperly_nested_timers;
     static constexpr char mainregion[] = "main";
+
+    // Timer and region names, indexed by id
+    std::mutex names_mutex;
+    std::vector<std::string> timer_names;
+    std::unordered_map<std::string, int> timer_ids;
+    std::vector<std::string> region_names;
+
+    std::mutex threads_mutex;
+    std::vector<std::unique_ptr<TinyProfiler::ThreadData> > all_threads;
+    thread_local TinyProfiler::ThreadData* this_thread = nullptr;
+
+    bool do_trace = false;
+    std::string trace_file;
+    long trace_max_events = 1000000L;
+
+    TinyProfiler::ThreadData& threadData ()
+    {
+        if (this_thread == nullptr) {
+            std::lock_guard<std::mutex> lock(threads_mutex);
+            all_threads.emplace_back(new TinyProfiler::ThreadData());
+            this_thread = all_threads.back().get();
+            this_thread->tid = all_threads.size()-1;
+        }
+        return *this_thread;
+    }
+
+    int timerId (const char* name)
+    {
+        auto& ids = threadData().cstr_ids;
+        auto it = ids.find(name);
+        if (it != ids.end() && it->second.second == name) {
+            return it->second.first;
+        }
+        const int id = TinyProfiler::RegisterTimer(name);
+        ids[name] = std::make_pair(id, std::string(name));
+        return id;
+    }
+
+    int timerId (const std::string& name)
+    {
+        auto& ids = threadData().str_ids;
+        auto it = ids.find(name);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        const int id = TinyProfiler::RegisterTimer(name);
+        ids[name] = id;
+        return id;
+    }
+
+    int regionId (const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(names_mutex);
+        auto it = std::find(region_names.begin(), region_names.end(), name);
+        if (it != region_names.end()) {
+            return it - region_names.begin();
+        }
+        region_names.push_back(name);
+        return region_names.size()-1;
+    }
+
+    bool inParallel ()
+    {
+#ifdef _OPENMP
+        return omp_in_parallel();
+#else
+        return false;
+#endif
+    }
 }
 
 TinyProfiler::TinyProfiler (std::string funcname) noexcept
-    : fname(std::move(funcname))
+    : timer_id(timerId(funcname))
 {
     start();
 }
 
 TinyProfiler::TinyProfiler (std::string funcname, bool start_) noexcept
-    : fname(std::move(funcname))
+    : timer_id(timerId(funcname))
 {
     if (start_) start();
 }
 
 TinyProfiler::TinyProfiler (const char* funcname) noexcept
-    : fname(funcname)
+    : timer_id(timerId(funcname))
 {
     start();
 }
 
 TinyProfiler::TinyProfiler (const char* funcname, bool start_) noexcept
-    : fname(funcname)
+    : timer_id(timerId(funcname))
+{
+    if (start_) start();
+}
+
+TinyProfiler::TinyProfiler (int a_timer_id, bool start_) noexcept
+    : timer_id(a_timer_id)
 {
     if (start_) start();
 }
@@ -58,28 +166,72 @@ TinyProfiler::~TinyProfiler ()
     stop();
 }
 
+int
+TinyProfiler::RegisterTimer (const std::string& name) noexcept
+{
+    std::lock_guard<std::mutex> lock(names_mutex);
+    auto it = timer_ids.find(name);
+    if (it != timer_ids.end()) {
+        return it->second;
+    }
+    const int id = timer_names.size();
+    timer_names.push_back(name);
+    timer_ids[name] = id;
+    return id;
+}
+
+TinyProfiler::Stats&
+TinyProfiler::getStats (ThreadData& td, int region, int id)
+{
+    if (static_cast<int>(td.stats.size()) <= region) {
+        td.stats.resize(region+1);
+    }
+    auto& regstats = td.stats[region];
+    if (static_cast<int>(regstats.size()) <= id) {
+        regstats.resize(id+1);
+    }
+    return regstats[id];
+}
+
+void
+TinyProfiler::snapshotRegions ()
+{
+    auto it = std::find(regionstacks.begin(), regionstacks.end(), regionstack);
+    if (it == regionstacks.end()) {
+        regionstacks.push_back(regionstack);
+        current_regions = &regionstacks.back();
+    } else {
+        current_regions = &(*it);
+    }
+}
+
 void
 TinyProfiler::start () noexcept
 {
-#ifdef _OPENMP
-#pragma omp master
-#endif
-    if (stats.empty() && !regionstack.empty())
+    // Regions are only changed outside of parallel regions, so the
+    // threads can read current_regions without a lock.
+    if (global_depth == 0 && current_regions != nullptr && !current_regions->empty())
     {
+        ThreadData& td = threadData();
 	double t = amrex::second();
 
-	ttstack.emplace_back(std::make_tuple(t, 0.0, &fname));
-	global_depth = ttstack.size();
+	td.stack.push_back({t, 0.0, timer_id});
+	global_depth = td.stack.size();
+        tdata = &td;
+        regions = current_regions;
 
 #ifdef AMREX_USE_CUDA
-	nvtx_id = nvtxRangeStartA(fname.c_str());
+        {
+            // Another thread may be adding a name.
+            std::lock_guard<std::mutex> lock(names_mutex);
+            nvtx_id = nvtxRangeStartA(timer_names[timer_id].c_str());
+        }
 #endif
 
-        for (auto const& region : regionstack)
+        for (int region : *regions)
         {
-            Stats& st = statsmap[region][fname];
+            Stats& st = getStats(td, region, timer_id);
             ++st.depth;
-            stats.push_back(&st);
         }
     }
 }
@@ -87,58 +239,75 @@ TinyProfiler::start () noexcept
 void
 TinyProfiler::stop () noexcept
 {
-#ifdef _OPENMP
-#pragma omp master
-#endif
-    if (!stats.empty()) 
+    if (global_depth > 0)
     {
+        ThreadData& td = *tdata;
 	double t = amrex::second();
 
-	while (static_cast<int>(ttstack.size()) > global_depth) {
-	    ttstack.pop_back();
+	while (static_cast<int>(td.stack.size()) > global_depth) {
+	    td.stack.pop_back();
 	};
 
-	if (static_cast<int>(ttstack.size()) == global_depth)
+	if (static_cast<int>(td.stack.size()) == global_depth)
 	{
-	    const std::tuple<double,double,std::string*>& tt = ttstack.back();
-	    
-	    // first: wall time when the pair is pushed into the stack
-	    // second: accumulated dt of children
-	    
-	    double dtin = t - std::get<0>(tt); // elapsed time since start() is called.
-	    double dtex = dtin - std::get<1>(tt);
+	    const ThreadData::Frame& frame = td.stack.back();
+
+	    double dtin = t - frame.t0; // elapsed time since start() is called.
+	    double dtex = dtin - frame.dt_children;
 
-            for (Stats* st : stats)
+            // The regions that were active at start, even if some have
+            // ended since, so that their depths go back to zero.
+            for (int region : *regions)
             {
-                --(st->depth);
-                ++(st->n);
-                if (st->depth == 0) {
-                    st->dtin += dtin;
+                Stats& st = getStats(td, region, timer_id);
+                --st.depth;
+                ++st.n;
+                if (st.depth == 0) {
+                    st.dtin += dtin;
                 }
-                st->dtex += dtex;
+                st.dtex += dtex;
             }
-                
-	    ttstack.pop_back();
-	    if (!ttstack.empty()) {
-		std::tuple<double,double,std::string*>& parent = ttstack.back();
-		std::get<1>(parent) += dtin;
+
+            if (do_trace) {
+                if (static_cast<long>(td.trace.size()) < trace_max_events) {
+                    td.trace.push_back({timer_id, frame.t0, t});
+                } else {
+                    ++td.trace_dropped;
+                }
+            }
+
+	    td.stack.pop_back();
+	    if (!td.stack.empty()) {
+		td.stack.back().dt_children += dtin;
 	    }
 
 #ifdef AMREX_USE_CUDA
 	    nvtxRangeEnd(nvtx_id);
 #endif
 	} else {
-	    improperly_nested_timers.insert(fname);
+	    td.improperly_nested_timers.insert(timer_id);
+            for (int region : *regions) {
+                --getStats(td, region, timer_id).depth;
+            }
 	} 
 
-        stats.clear();
+        global_depth = 0;
     }
 }
 
 void
 TinyProfiler::Initialize () noexcept
 {
-    regionstack.push_back(mainregion);
+    {
+        ParmParse pp("tiny_profiler");
+        pp.query("trace_file", trace_file);
+        pp.query("trace_max_events", trace_max_events);
+        do_trace = !trace_file.empty();
+    }
+
+    threadData();  // so that the main thread is thread 0
+    regionstack.push_back(regionId(mainregion));
+    snapshotRegions();
     t_init = amrex::second();
 }
 
@@ -156,8 +325,30 @@ TinyProfiler::Finalize (bool bFlushing) noexcept
 
     double t_final = amrex::second();
 
-    // make a local copy so that any functions call after this will not be recorded in the local copy.
-    auto lstatsmap = statsmap;
+    // Merge the threads into a local map so that any functions called
+    // after this will not be recorded in it.
+    std::map<std::string,std::map<std::string, Stats> > lstatsmap;
+    std::set<std::string> improperly_nested_timers;
+    for (auto const& td : all_threads)
+    {
+        for (int r = 0, nr = td->stats.size(); r < nr; ++r)
+        {
+            auto& regstats = lstatsmap[region_names[r]];
+            for (int id = 0, ni = td->stats[r].size(); id < ni; ++id)
+            {
+                const Stats& st = td->stats[r][id];
+                if (st.n > 0 || st.depth > 0) {
+                    Stats& mst = regstats[timer_names[id]];
+                    mst.n += st.n;
+                    mst.dtin = std::max(mst.dtin, st.dtin);
+                    mst.dtex = std::max(mst.dtex, st.dtex);
+                }
+            }
+        }
+        for (int id : td->improperly_nested_timers) {
+            improperly_nested_timers.insert(timer_names[id]);
+        }
+    }
 
     bool properly_nested = improperly_nested_timers.size() == 0;
     ParallelDescriptor::ReduceBoolAnd(properly_nested);
@@ -228,6 +419,79 @@ TinyProfiler::Finalize (bool bFlushing) noexcept
             amrex::Print() << "END REGION " << kv.first << "\n";
         }
     }
+
+    if (do_trace && !bFlushing) {
+        WriteTrace();
+    }
+}
+
+// The ranks append their events to the file in turn.
+void
+TinyProfiler::WriteTrace ()
+{
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int myproc = ParallelDescriptor::MyProc();
+    const int tag = ParallelDescriptor::SeqNum();
+
+    long ndropped = 0;
+    for (auto const& td : all_threads) {
+        ndropped += td->trace_dropped;
+    }
+    ParallelDescriptor::ReduceLongSum(ndropped);
+    if (ndropped > 0) {
+        amrex::Print() << "TinyProfiler: " << ndropped << " trace events were dropped;"
+                       << " increase tiny_profiler.trace_max_events to keep them\n";
+    }
+
+    // number of events written by the ranks before
+    long nwritten = 0;
+    if (myproc > 0) {
+        ParallelDescriptor::Recv(&nwritten, 1, myproc-1, tag);
+    }
+
+    {
+        std::ofstream ofs(trace_file, (myproc == 0) ? std::ios::out : std::ios::app);
+        if (!ofs.good()) {
+            amrex::FileOpenFailed(trace_file);
+        }
+        ofs << std::setprecision(15);
+
+        auto escaped = [] (const std::string& name) -> std::string {
+            std::string r;
+            for (char c : name) {
+                if (c == '"' || c == '\\') r.push_back('\\');
+                r.push_back(c);
+            }
+            return r;
+        };
+
+        if (myproc == 0) {
+            ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        }
+
+        ofs << (nwritten > 0 ? ",\n" : "")
+            << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << myproc
+            << ",\"args\":{\"name\":\"rank " << myproc << "\"}}";
+        ++nwritten;
+
+        for (auto const& td : all_threads) {
+            for (auto const& ev : td->trace) {
+                ofs << ",\n{\"name\":\"" << escaped(timer_names[ev.id])
+                    << "\",\"ph\":\"X\",\"ts\":" << (ev.t0-t_init)*1.e6
+                    << ",\"dur\":" << (ev.t1-ev.t0)*1.e6
+                    << ",\"pid\":" << myproc << ",\"tid\":" << td->tid << "}";
+            }
+            nwritten += td->trace.size();
+        }
+
+        if (myproc == nprocs-1) {
+            ofs << "\n]}\n";
+        }
+    }
+
+    if (myproc < nprocs-1) {
+        ParallelDescriptor::Send(&nwritten, 1, myproc+1, tag);
+    }
 }
 
 void
@@ -380,16 +644,23 @@ TinyProfiler::PrintStats (std::map<std::string,Stats>& regstats, double dt_max)
 void
 TinyProfiler::StartRegion (std::string regname) noexcept
 {
-    if (std::find(regionstack.begin(), regionstack.end(), regname) == regionstack.end()) {
-        regionstack.emplace_back(std::move(regname));
+    if (inParallel()) return;
+
+    const int id = regionId(regname);
+    if (std::find(regionstack.begin(), regionstack.end(), id) == regionstack.end()) {
+        regionstack.push_back(id);
+        snapshotRegions();
     }
 }
 
 void
 TinyProfiler::StopRegion (const std::string& regname) noexcept
 {
-    if (regname == regionstack.back()) {
+    if (inParallel()) return;
+
+    if (regname == region_names[regionstack.back()]) {
         regionstack.pop_back();
+        snapshotRegions();
     }
 }
 
@@ -419,8 +690,10 @@ void
 TinyProfiler::PrintCallStack (std::ostream& os)
 {
     os << "===== TinyProfilers ======\n";
-    for (auto const& x : ttstack) {
-        os << *(std::get<2>(x)) << "\n";
+    if (this_thread != nullptr) {
+        for (auto const& x : this_thread->stack) {
+            os << timer_names[x.id] << "\n";
+        }
     }
 }
 
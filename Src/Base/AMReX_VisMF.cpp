@@ -6,6 +6,9 @@
 #include <cerrno>
 #include <atomic>
 #include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
 #include <limits>
 #include <array>
 #include <numeric>
@@ -17,6 +20,8 @@
 #include <AMReX_NFiles.H>
 #include <AMReX_FPC.H>
 #include <AMReX_FabArrayUtility.H>
+#include <AMReX_FabCodec.H>
+#include <AMReX_MappedFile.H>
 
 namespace amrex {
 
@@ -36,9 +41,12 @@ bool VisMF::checkFilePositions(false);
 bool VisMF::usePersistentIFStreams(false);
 bool VisMF::useSynchronousReads(false);
 bool VisMF::useDynamicSetSelection(true);
+bool VisMF::useMmap(false);
 bool VisMF::allowSparseWrites(true);
 
 long VisMF::ioBufferSize(VisMF::IO_Buffer_Size);
+std::string VisMF::codecName("shuffle_lz");
+Real VisMF::codecParam(0.0);
 
 
 //
@@ -84,8 +92,11 @@ VisMF::Initialize ()
     pp.query("usepersistentifstreams", usePersistentIFStreams);
     pp.query("usesynchronousreads", useSynchronousReads);
     pp.query("usedynamicsetselection", useDynamicSetSelection);
+    pp.query("usemmap", useMmap);
     pp.query("iobuffersize", ioBufferSize);
     pp.query("allowsparsewrites", allowSparseWrites);
+    pp.query("codec", codecName);
+    pp.query("codec_param", codecParam);
 
     initialized = true;
 }
@@ -93,6 +104,7 @@ VisMF::Initialize ()
 void
 VisMF::Finalize ()
 {
+    VisMF::ClearMappedFiles();
     initialized = false;
 }
 
@@ -284,7 +296,8 @@ operator<< (std::ostream        &os,
     os << hd.m_fod      << '\n';
 
     if(hd.m_vers == VisMF::Header::Version_v1 ||
-       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1)
+       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       hd.m_vers == VisMF::Header::Compressed_v1)
     {
       os << hd.m_min      << '\n';
       os << hd.m_max      << '\n';
@@ -316,6 +329,19 @@ operator<< (std::ostream        &os,
       }
     }
 
+    if(hd.m_vers == VisMF::Header::Compressed_v1) {
+      // ---- the data are compressed in the native format
+      os << FPC::NativeRealDescriptor() << '\n';
+      os << hd.m_codec << ' ' << hd.m_codec_param << '\n';
+      os << hd.m_csize.size() << ' ' << hd.m_ncomp << '\n';
+      for(int i(0); i < hd.m_csize.size(); ++i) {
+        for(int j(0); j < hd.m_csize[i].size(); ++j) {
+          os << hd.m_csize[i][j] << ' ';
+        }
+        os << '\n';
+      }
+    }
+
     os.flags(oflags);
     os.precision(oldPrec);
 
@@ -368,7 +394,8 @@ operator>> (std::istream  &is,
     BL_ASSERT(hd.m_ba.size() == hd.m_fod.size());
 
     if(hd.m_vers == VisMF::Header::Version_v1 ||
-       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1)
+       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       hd.m_vers == VisMF::Header::Compressed_v1)
     {
       is >> hd.m_min;
       is >> hd.m_max;
@@ -400,6 +427,21 @@ operator>> (std::istream  &is,
       is >> hd.m_writtenRD;
     }
 
+    if(hd.m_vers == VisMF::Header::Compressed_v1) {
+      is >> hd.m_writtenRD;
+      is >> hd.m_codec >> hd.m_codec_param;
+      long nfabs;
+      int ncomp;
+      is >> nfabs >> ncomp;
+      hd.m_csize.resize(nfabs);
+      for(long i(0); i < nfabs; ++i) {
+        hd.m_csize[i].resize(ncomp);
+        for(int j(0); j < ncomp; ++j) {
+          is >> hd.m_csize[i][j];
+        }
+      }
+    }
+
 
     if( ! is.good()) {
         amrex::Error("Read of VisMF::Header failed");
@@ -639,7 +681,8 @@ VisMF::Write (const FArrayBox&   fab,
 
 VisMF::Header::Header ()
     :
-    m_vers(VisMF::Header::Undefined_v1)
+    m_vers(VisMF::Header::Undefined_v1),
+    m_codec_param(0.0)
 {}
 
 //
@@ -657,7 +700,8 @@ VisMF::Header::Header (const FabArray<FArrayBox>& mf,
     m_ncomp(mf.nComp()),
     m_ngrow(mf.nGrowVect()),
     m_ba(mf.boxArray()),
-    m_fod(m_ba.size())
+    m_fod(m_ba.size()),
+    m_codec_param(0.0)
 {
 //    BL_PROFILE("VisMF::Header");
 
@@ -952,6 +996,11 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
         }
     }
 
+    if(currentVersion == VisMF::Header::Compressed_v1) {
+      delete whichRD;
+      return VisMF::WriteCompressed(mf, mf_name);
+    }
+
     // ---- check if mf has sparse data
     bool useSparseFPP(false);
     const Vector<int> &pmap = mf.DistributionMap().ProcessorMap();
@@ -1124,6 +1173,133 @@ VisMF::WriteOnlyHeader (const FabArray<FArrayBox> & mf,
 }
 
 
+long
+VisMF::WriteCompressed (const FabArray<FArrayBox> &mf,
+                        const std::string         &mf_name)
+{
+    BL_PROFILE("VisMF::WriteCompressed()");
+
+    Real tStart(amrex::second());
+    const int nComps(mf.nComp());
+    const int nLocal(mf.local_size());
+    const Vector<int> &localIndex = mf.IndexArray();
+
+    std::unique_ptr<FabCodec> codec(FabCodec::Create(codecName, codecParam));
+
+    // ---- each component of each fab is an independent chunk
+    Vector<Vector<char> > chunks(nLocal * nComps);
+    long rawBytes(0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1) reduction(+:rawBytes)
+#endif
+    for(int i = 0; i < nLocal * nComps; ++i) {
+      const FArrayBox &fab = mf[localIndex[i / nComps]];
+      const long nPts(fab.box().numPts());
+      codec->compress(fab.dataPtr(i % nComps), nPts, chunks[i]);
+      rawBytes += nPts * sizeof(Real);
+    }
+    Real tCompress(amrex::second() - tStart);
+
+    bool calcMinMax(false);
+    VisMF::Header hdr(mf, VisMF::NFiles, VisMF::Header::Compressed_v1, calcMinMax);
+    hdr.m_codec       = codecName;
+    hdr.m_codec_param = codecParam;
+
+    std::string filePrefix(mf_name + FabFileSuffix);
+    NFilesIter nfi(nOutFiles, filePrefix, groupSets, setBuf);
+    if(useDynamicSetSelection) {
+      nfi.SetDynamic();
+    }
+
+    // ---- [file number, offset, compressed bytes of each component] for each fab
+    const int nItems(2 + nComps);
+    Vector<long> localData(std::max(nLocal * nItems, 1), 0L);
+    long bytesWritten(0);
+    for( ; nfi.ReadyToWrite(); ++nfi) {
+      for(int li(0); li < nLocal; ++li) {
+        long *ld = localData.dataPtr() + li * nItems;
+        ld[0] = nfi.FileNumber();
+        ld[1] = VisMF::FileOffset(nfi.Stream());
+        for(int n(0); n < nComps; ++n) {
+          const Vector<char> &chunk = chunks[li * nComps + n];
+          nfi.Stream().write(chunk.dataPtr(), chunk.size());
+          ld[2 + n] = chunk.size();
+          bytesWritten += chunk.size();
+        }
+      }
+      nfi.Stream().flush();
+    }
+    Vector<Vector<char> >().swap(chunks);
+
+    int coordinatorProc(ParallelDescriptor::IOProcessorNumber());
+    const int myProc(ParallelDescriptor::MyProc());
+    const int nBoxes(mf.size());
+    const Vector<int> &pmap = mf.DistributionMap().ProcessorMap();
+
+    Vector<long> allData;
+    Vector<int> offset;
+#ifdef BL_USE_MPI
+    {
+      const int nProcs(ParallelDescriptor::NProcs());
+      Vector<int> nItemsOnProc(nProcs, 0);
+      offset.resize(nProcs, 0);
+      for(int i(0); i < nBoxes; ++i) {
+        nItemsOnProc[pmap[i]] += nItems;
+      }
+      for(int i(1); i < nProcs; ++i) {
+        offset[i] = offset[i-1] + nItemsOnProc[i-1];
+      }
+      if(myProc == coordinatorProc) {
+        allData.resize(std::max(nBoxes * nItems, 1));
+      }
+      BL_MPI_REQUIRE( MPI_Gatherv(localData.dataPtr(), nLocal * nItems,
+                                  ParallelDescriptor::Mpi_typemap<long>::type(),
+                                  allData.dataPtr(), nItemsOnProc.dataPtr(),
+                                  offset.dataPtr(),
+                                  ParallelDescriptor::Mpi_typemap<long>::type(),
+                                  coordinatorProc, ParallelDescriptor::Communicator()) );
+    }
+#else
+    allData = localData;
+    offset.resize(1, 0);
+#endif
+
+    if(myProc == coordinatorProc) {
+      // ---- the data from each rank are in local index order
+      Vector<int> cnt(offset.size(), 0);
+      hdr.m_csize.resize(nBoxes);
+      for(int j(0); j < nBoxes; ++j) {
+        const int i(pmap[j]);
+        const long *ad = allData.dataPtr() + offset[i] + cnt[i] * nItems;
+        hdr.m_fod[j].m_name = VisMF::BaseName(NFilesIter::FileName(ad[0], filePrefix));
+        hdr.m_fod[j].m_head = ad[1];
+        hdr.m_csize[j].assign(ad + 2, ad + nItems);
+        ++cnt[i];
+      }
+    }
+
+    hdr.CalculateMinMax(mf, coordinatorProc);
+
+    bytesWritten += VisMF::WriteHeader(mf_name, hdr, coordinatorProc);
+
+    if(verbose) {
+      Real tTotal(amrex::second() - tStart);
+      long bytes[2] = { rawBytes, bytesWritten };
+      ParallelDescriptor::ReduceLongSum(bytes, 2);
+      ParallelDescriptor::ReduceRealMax(tCompress);
+      ParallelDescriptor::ReduceRealMax(tTotal);
+      amrex::Print() << "VisMF::WriteCompressed:  " << mf_name << "  codec = " << codecName
+                     << "  raw bytes = " << bytes[0] << "  bytes written = " << bytes[1]
+                     << "  ratio = " << Real(bytes[0]) / std::max(bytes[1], 1L)
+                     << "  compress time = " << tCompress << "  total time = " << tTotal
+                     << "  bandwidth = " << bytes[0] / (1048576.0 * std::max(tTotal, Real(1.e-12)))
+                     << " MB/s\n";
+    }
+
+    return bytesWritten;
+}
+
+
 void
 VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
 		    const std::string &filePrefix,
@@ -1369,6 +1545,15 @@ VisMF::readFAB (int                  idx,
 
     FArrayBox *fab = new FArrayBox(fab_box, whichComp == -1 ? hdr.m_ncomp : 1);
 
+    if(hdr.m_vers == Header::Compressed_v1) {
+      VisMF::readCompressedFAB(*fab, idx, mf_name, hdr, whichComp);
+      return fab;
+    }
+
+    if(useMmap && VisMF::readMappedFAB(*fab, idx, mf_name, hdr, whichComp)) {
+      return fab;
+    }
+
     std::string FullName(VisMF::DirName(mf_name));
     FullName += hdr.m_fod[idx].m_name;
 
@@ -1419,6 +1604,15 @@ VisMF::readFAB (FabArray<FArrayBox> &mf,
 //    BL_PROFILE("VisMF::readFAB_mf");
     FArrayBox &fab = mf[idx];
 
+    if(hdr.m_vers == Header::Compressed_v1) {
+      VisMF::readCompressedFAB(fab, idx, mf_name, hdr, -1);
+      return;
+    }
+
+    if(useMmap && VisMF::readMappedFAB(fab, idx, mf_name, hdr, -1)) {
+      return;
+    }
+
     std::string FullName(VisMF::DirName(mf_name));
     FullName += hdr.m_fod[idx].m_name;
 
@@ -1441,6 +1635,155 @@ VisMF::readFAB (FabArray<FArrayBox> &mf,
 }
 
 
+char*
+VisMF::mappedFABData (int                  idx,
+                      const std::string   &mf_name,
+                      const VisMF::Header &hdr,
+                      RealDescriptor      &rd,
+                      std::shared_ptr<MappedFile>* mfile_out)
+{
+    if(hdr.m_vers == Header::Compressed_v1) {
+      return nullptr;
+    }
+
+    std::string FullName(VisMF::DirName(mf_name));
+    FullName += hdr.m_fod[idx].m_name;
+
+    // ---- the cache keeps the mapping alive
+    std::shared_ptr<MappedFile> mfile = MappedFile::Get(FullName);
+    char *pEnd = mfile->data() + mfile->size();
+    if(hdr.m_fod[idx].m_head < 0 || hdr.m_fod[idx].m_head >= static_cast<long>(mfile->size())) {
+      amrex::Abort("VisMF::mappedFABData:  bad offset in " + FullName);
+    }
+    char *p = mfile->data() + hdr.m_fod[idx].m_head;
+
+    if(hdr.m_vers == Header::Version_v1) {
+      // ---- skip the fab header, which is one line.  old style fabs are not supported.
+      char *eol = static_cast<char *>(std::memchr(p, '\n', std::min(pEnd - p, 4096L)));
+      if(eol == nullptr || std::strncmp(p, "FAB (", 5) != 0) {
+        return nullptr;
+      }
+      std::istringstream is(std::string(p + 4, eol));
+      is >> rd;
+      if(is.fail()) {
+        return nullptr;
+      }
+      p = eol + 1;
+    } else {
+      rd = hdr.m_writtenRD;
+    }
+
+    Box fab_box(hdr.m_ba[idx]);
+    if(hdr.m_ngrow.max() > 0) {
+      fab_box.grow(hdr.m_ngrow);
+    }
+    if(fab_box.numPts() * hdr.m_ncomp * rd.numBytes() > pEnd - p) {
+      amrex::Abort("VisMF::mappedFABData:  " + FullName + " is too short");
+    }
+
+    if(mfile_out) {
+      *mfile_out = mfile;
+    }
+    return p;
+}
+
+
+bool
+VisMF::readMappedFAB (FArrayBox           &fab,
+                      int                  idx,
+                      const std::string   &mf_name,
+                      const VisMF::Header &hdr,
+                      int                  whichComp)
+{
+    RealDescriptor rd;
+    char *p = VisMF::mappedFABData(idx, mf_name, hdr, rd);
+    if(p == nullptr) {
+      return false;
+    }
+
+    // ---- only the pages of the requested components are touched.
+    // ---- convert one component at a time, so each is read just once
+    const long nPts(fab.box().numPts());
+    const int nComp(whichComp == -1 ? hdr.m_ncomp : 1);
+    if(whichComp > 0) {
+      p += whichComp * nPts * rd.numBytes();
+    }
+    if(rd == FPC::NativeRealDescriptor()) {
+      std::memcpy(fab.dataPtr(), p, nComp * nPts * sizeof(Real));
+    } else {
+      for(int n(0); n < nComp; ++n) {
+        RealDescriptor::convertToNativeFormat(fab.dataPtr(n), nPts,
+                                              p + n * nPts * rd.numBytes(), rd);
+      }
+    }
+    return true;
+}
+
+
+std::shared_ptr<FArrayBox>
+VisMF::mapFAB (int idx) const
+{
+    RealDescriptor rd;
+    std::shared_ptr<MappedFile> mfile;
+    char *p = VisMF::mappedFABData(idx, m_fafabname, m_hdr, rd, &mfile);
+    if(p == nullptr || rd != FPC::NativeRealDescriptor() ||
+       reinterpret_cast<std::uintptr_t>(p) % alignof(Real) != 0)
+    {
+      return nullptr;
+    }
+
+    Box fab_box(m_hdr.m_ba[idx]);
+    if(m_hdr.m_ngrow.max() > 0) {
+      fab_box.grow(m_hdr.m_ngrow);
+    }
+    // ---- the cache drops a mapping when its file changes, so the fab keeps it
+    return std::shared_ptr<FArrayBox>(new FArrayBox(fab_box, m_hdr.m_ncomp, reinterpret_cast<Real *>(p)),
+                                      [mfile] (FArrayBox* fab) { delete fab; });
+}
+
+
+void
+VisMF::readCompressedFAB (FArrayBox         &fab,
+                          int                idx,
+                          const std::string &mf_name,
+                          const VisMF::Header &hdr,
+                          int                whichComp)
+{
+    if(hdr.m_writtenRD != FPC::NativeRealDescriptor()) {
+      amrex::Abort("VisMF::readCompressedFAB:  the data were written with a different Real type");
+    }
+    std::unique_ptr<FabCodec> codec(FabCodec::Create(hdr.m_codec, hdr.m_codec_param));
+
+    std::string FullName(VisMF::DirName(mf_name));
+    FullName += hdr.m_fod[idx].m_name;
+
+    // ---- only the requested components are read
+    const Vector<long> &csize = hdr.m_csize[idx];
+    const int firstComp(whichComp == -1 ? 0 : whichComp);
+    const int lastComp(whichComp == -1 ? hdr.m_ncomp - 1 : whichComp);
+    long seekPos(hdr.m_fod[idx].m_head);
+    for(int n(0); n < firstComp; ++n) {
+      seekPos += csize[n];
+    }
+
+    std::ifstream *infs = VisMF::OpenStream(FullName);
+    infs->seekg(seekPos, std::ios::beg);
+
+    const long nPts(fab.box().numPts());
+    Vector<char> chunk;
+    for(int n(firstComp); n <= lastComp; ++n) {
+      chunk.resize(csize[n]);
+      infs->read(chunk.dataPtr(), csize[n]);
+      if( ! infs->good()) {
+        amrex::Error("VisMF::readCompressedFAB:  read failed");
+      }
+      codec->decompress(chunk.dataPtr(), csize[n], fab.dataPtr(n - firstComp), nPts);
+    }
+
+    VisMF::CloseStream(FullName);
+}
+
+
 void
 VisMF::Read (FabArray<FArrayBox> &mf,
              const std::string   &mf_name,
@@ -2132,10 +2475,22 @@ void VisMF::CloseAllStreams() {
   VisMF::persistentIFStreams.clear();
 }
 
+void VisMF::ClearMappedFiles() {
+  MappedFile::ClearCache();
+}
+
 std::future<WriteAsyncStatus>
 VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
 {
     BL_PROFILE("VisMF::WriteAysnc()");
+    return std::async(std::launch::async, SnapshotAsync(mf, mf_name, FArrayBox::getFormat()));
+}
+
+std::function<WriteAsyncStatus()>
+VisMF::SnapshotAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name,
+                      FABio::Format fmt)
+{
+    BL_PROFILE("VisMF::SnapshotAsync()");
     AMREX_ASSERT(mf_name[mf_name.length() - 1] != '/');
 
     const int nfiles = nOutFiles;
@@ -2146,13 +2501,14 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
     int myproc = ParallelDescriptor::MyProc();
     int nprocs = ParallelDescriptor::NProcs();
 
-    RealDescriptor const& whichRD = []() -> RealDescriptor const& {
-        switch (FArrayBox::getFormat())
+    RealDescriptor const& whichRD = [fmt]() -> RealDescriptor const& {
+        switch (fmt)
         {
         case FABio::FAB_NATIVE:
             return FPC::NativeRealDescriptor();
         case FABio::FAB_NATIVE_32:
             return FPC::Native32RealDescriptor();
+        case FABio::FAB_IEEE:
         case FABio::FAB_IEEE_32:
             return FPC::Ieee32NormalRealDescriptor();
         default:
@@ -2160,6 +2516,9 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
         }
     }();
     bool doConvert = whichRD != FPC::NativeRealDescriptor();
+    // The FAB headers must describe the data as written.
+    std::unique_ptr<FABio> fio_ptr(FArrayBox::newFABio(fmt));
+    const FABio& fio = *fio_ptr;
 
     VisMF::Header hdr(mf, VisMF::NFiles, VisMF::Header::Version_v1, true);
 
@@ -2204,7 +2563,6 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
 
     int64_t total_bytes = 0;
     auto pld = (char*)(&(localdata[1]));
-    const FABio& fio = FArrayBox::getFABio();
     for (MFIter mfi(mf); mfi.isValid(); ++mfi)
     {
         std::memcpy(pld, &total_bytes, sizeof(int64_t));
@@ -2293,8 +2651,8 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
     }
 #endif
 
-    std::unique_ptr<char,DataDeleter> alldata((char*)(The_Pinned_Arena()->alloc(total_bytes)),
-                                              DataDeleter(The_Pinned_Arena()));
+    std::shared_ptr<char> alldata((char*)(The_Pinned_Arena()->alloc(total_bytes)),
+                                  DataDeleter(The_Pinned_Arena()));
     char* p = alldata.get();
     void* ptmp;
     for (MFIter mfi(mf); mfi.isValid(); ++mfi)
@@ -2324,10 +2682,15 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
         p += nreals * whichRD.numBytes();
     }
 
-    auto af = std::async(std::launch::async,
-    [=] (std::unique_ptr<char,DataDeleter> d, Header h, Vector<int64_t> const& gdata)
-         -> WriteAsyncStatus
+    // Shared so that the returned function can be copied.
+    auto phdr = std::make_shared<Header>(std::move(hdr));
+    auto pgdata = std::make_shared<Vector<int64_t> >(std::move(globaldata));
+
+    return [=] () -> WriteAsyncStatus
     {
+        const char* d = alldata.get();
+        Header& h = *phdr;
+        Vector<int64_t> const& gdata = *pgdata;
         Real tbegin = amrex::second();
         if (myproc == nprocs-1)
         {
@@ -2442,7 +2805,7 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
                      ? (std::ios::binary | std::ios::trunc)
                      : (std::ios::binary | std::ios::app));
             if (!ofs.good()) amrex::FileOpenFailed(file_name);
-            ofs.write(d.get(), total_bytes);
+            ofs.write(d, total_bytes);
             ofs.close();
         }
 
@@ -2465,10 +2828,7 @@ VisMF::WriteAsync (const FabArray<FArrayBox>& mf, const std::string& mf_name)
         status.t_write = t2-t1;
         status.t_send = tend-t2;
         return status;
-    },
-    std::move(alldata), std::move(hdr), std::move(globaldata));
-
-    return af;
+    };
 }
 
 std::ostream&
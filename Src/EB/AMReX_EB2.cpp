@@ -10,8 +10,11 @@
 #include <AMReX_EB2_GeometryShop.H>
 #include <AMReX_EB2.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_PlotFileUtil.H>
 #include <AMReX.H>
 #include <algorithm>
+#include <fstream>
+#include <sstream>
 
 namespace amrex { namespace EB2 {
 
@@ -56,6 +59,122 @@ IndexSpace::erase (IndexSpace* ispace)
     }
 }
 
+void
+IndexSpace::writeLevels (const std::string& dirname, const Vector<Geometry>& geom,
+                         const Vector<Level const*>& levels)
+{
+    BL_PROFILE("EB2::IndexSpace::write()");
+
+    const int nlevels = levels.size();
+    amrex::PreBuildDirectorHierarchy(dirname, "Level_", nlevels, true);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        std::string HeaderFileName = dirname + "/Header";
+        VisMF::IO_Buffer io_buffer(VisMF::GetIOBufferSize());
+        std::ofstream HeaderFile;
+        HeaderFile.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
+        HeaderFile.open(HeaderFileName.c_str(), std::ios::out | std::ios::trunc |
+                                                std::ios::binary);
+        if ( ! HeaderFile.good()) {
+            amrex::FileOpenFailed(HeaderFileName);
+        }
+
+        HeaderFile.precision(17);
+        HeaderFile << "EB2::IndexSpace-V1\n"
+                   << AMREX_SPACEDIM << '\n'
+                   << nlevels << '\n';
+        for (int ilev = 0; ilev < nlevels; ++ilev) {
+            HeaderFile << geom[ilev] << '\n';
+        }
+    }
+
+    for (int ilev = 0; ilev < nlevels; ++ilev) {
+        levels[ilev]->write(amrex::LevelFullPath(ilev, dirname));
+    }
+}
+
+IndexSpaceChkptFile::IndexSpaceChkptFile (const std::string& dirname, const Geometry& geom,
+                                          int required_coarsening_level,
+                                          int max_coarsening_level)
+{
+    AMREX_ALWAYS_ASSERT(required_coarsening_level >= 0 && required_coarsening_level <= 30);
+    max_coarsening_level = std::max(required_coarsening_level,max_coarsening_level);
+    max_coarsening_level = std::min(30,max_coarsening_level);
+
+    Vector<char> fileCharPtr;
+    ParallelDescriptor::ReadAndBcastFile(dirname+"/Header", fileCharPtr);
+    std::string fileCharPtrString(fileCharPtr.dataPtr());
+    std::istringstream is(fileCharPtrString, std::istringstream::in);
+
+    std::string version;
+    int dim, nlevels;
+    Geometry fgeom;
+    is >> version >> dim >> nlevels >> fgeom;
+    if (is.fail() || version != "EB2::IndexSpace-V1") {
+        amrex::Abort("EB2::IndexSpaceChkptFile: failed to read "+dirname+"/Header");
+    }
+    if (dim != AMREX_SPACEDIM) {
+        amrex::Abort("EB2::IndexSpaceChkptFile: "+dirname+" was written in "
+                     +std::to_string(dim)+"D");
+    }
+
+    bool same_geom = fgeom.Domain() == geom.Domain() && fgeom.Coord() == geom.Coord();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        const Real tol = 1.e-6*geom.ProbLength(idim);
+        same_geom = same_geom
+            && fgeom.isPeriodic(idim) == geom.isPeriodic(idim)
+            && std::abs(fgeom.ProbLo(idim)-geom.ProbLo(idim)) <= tol
+            && std::abs(fgeom.ProbHi(idim)-geom.ProbHi(idim)) <= tol;
+    }
+    if (!same_geom) {
+        amrex::Abort("EB2::IndexSpaceChkptFile: the Geometry in "+dirname+" does not match");
+    }
+
+    if (nlevels <= required_coarsening_level) {
+        amrex::Abort("EB2::IndexSpaceChkptFile: "+dirname+" has only "+std::to_string(nlevels)
+                     +" levels, but required_coarsening_level is "
+                     +std::to_string(required_coarsening_level));
+    }
+    nlevels = std::min(nlevels, max_coarsening_level+1);
+
+    m_chkptlevel.reserve(nlevels);
+    for (int ilev = 0; ilev < nlevels; ++ilev)
+    {
+        Geometry g = (ilev == 0) ? geom : amrex::coarsen(m_geom.back(),2);
+        ChkptFileLevel const* fine = (ilev == 0) ? nullptr : &m_chkptlevel[ilev-1];
+        m_chkptlevel.emplace_back(this, amrex::LevelFullPath(ilev, dirname), g, fine);
+        m_geom.push_back(g);
+        m_domain.push_back(g.Domain());
+    }
+}
+
+const Level&
+IndexSpaceChkptFile::getLevel (const Geometry& geom) const
+{
+    auto it = std::find(std::begin(m_domain), std::end(m_domain), geom.Domain());
+    int i = std::distance(m_domain.begin(), it);
+    return m_chkptlevel[i];
+}
+
+const Geometry&
+IndexSpaceChkptFile::getGeometry (const Box& dom) const
+{
+    auto it = std::find(std::begin(m_domain), std::end(m_domain), dom);
+    int i = std::distance(m_domain.begin(), it);
+    return m_geom[i];
+}
+
+void
+IndexSpaceChkptFile::write (const std::string& dirname) const
+{
+    Vector<Level const*> levels;
+    for (auto const& lev : m_chkptlevel) {
+        levels.push_back(&lev);
+    }
+    writeLevels(dirname, m_geom, levels);
+}
+
 const IndexSpace* TopIndexSpaceIfPresent() noexcept {
     if (IndexSpace::size() > 0) {
         return &IndexSpace::top();
@@ -170,12 +289,30 @@ Build (const Geometry& geom, int required_coarsening_level,
         EB2::Build(gshop, geom, required_coarsening_level,
                    max_coarsening_level, ngrow);
     }
+    else if (geom_type == "chkpt_file")
+    {
+        std::string chkpt_file;
+        pp.get("chkpt_file", chkpt_file);
+
+        EB2::BuildFromChkptFile(chkpt_file, geom, required_coarsening_level,
+                                max_coarsening_level);
+    }
     else
     {
         amrex::Abort("geom_type "+geom_type+ " not supported");
     }
 }
 
+void
+BuildFromChkptFile (const std::string& dirname, const Geometry& geom,
+                    int required_coarsening_level, int max_coarsening_level)
+{
+    BL_PROFILE("EB2::BuildFromChkptFile()");
+    IndexSpace::push(new IndexSpaceChkptFile(dirname, geom,
+                                             required_coarsening_level,
+                                             max_coarsening_level));
+}
+
 namespace {
 static int comp_max_crse_level (Box cdomain, const Box& domain)
 {
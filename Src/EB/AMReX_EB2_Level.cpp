@@ -2,6 +2,8 @@
 #include <AMReX_EB2_Level.H>
 #include <AMReX_IArrayBox.H>
 #include <algorithm>
+#include <fstream>
+#include <sstream>
 
 namespace amrex { namespace EB2 {
 
@@ -845,4 +847,152 @@ Level::fillLevelSet (MultiFab& levelset, const Geometry& geom) const
     }
 }
         
+void
+Level::write (const std::string& dirname) const
+{
+    BL_PROFILE("EB2::Level::write()");
+
+    const int ng = m_grids.empty() ? 0 : m_cellflag.nGrow();
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        std::string HeaderFileName = dirname + "/Header";
+        VisMF::IO_Buffer io_buffer(VisMF::GetIOBufferSize());
+        std::ofstream HeaderFile;
+        HeaderFile.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
+        HeaderFile.open(HeaderFileName.c_str(), std::ios::out | std::ios::trunc |
+                                                std::ios::binary);
+        if ( ! HeaderFile.good()) {
+            amrex::FileOpenFailed(HeaderFileName);
+        }
+
+        HeaderFile << m_allregular << '\n'
+                   << m_ok << '\n'
+                   << m_ngrow << '\n'
+                   << ng << '\n';
+        // BoxArray::readFrom cannot read an empty BoxArray.
+        for (BoxArray const* ba : {&m_grids, &m_covered_grids}) {
+            HeaderFile << ba->size() << '\n';
+            if (!ba->empty()) {
+                ba->writeOn(HeaderFile);
+                HeaderFile << '\n';
+            }
+        }
+    }
+
+    if (m_grids.empty()) return;
+
+    // VisMF only writes floating point data.  The flags are split into two
+    // 16-bit halves so that they are exact in single precision too.
+    MultiFab cellflag(m_grids, m_dmap, 2, ng);
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(cellflag); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.fabbox();
+        auto const& dst = cellflag.array(mfi);
+        auto const& src = m_cellflag.const_array(mfi);
+        AMREX_HOST_DEVICE_FOR_3D(bx, i, j, k,
+        {
+            const uint32_t v = src(i,j,k).getValue();
+            dst(i,j,k,0) = static_cast<Real>(v & 0xFFFFu);
+            dst(i,j,k,1) = static_cast<Real>(v >> 16);
+        });
+    }
+
+    VisMF::Write(cellflag, dirname+"/CellFlag");
+    VisMF::Write(m_levelset, dirname+"/LevelSet");
+    VisMF::Write(m_volfrac, dirname+"/VolFrac");
+    VisMF::Write(m_centroid, dirname+"/Centroid");
+    VisMF::Write(m_bndryarea, dirname+"/BndryArea");
+    VisMF::Write(m_bndrycent, dirname+"/BndryCent");
+    VisMF::Write(m_bndrynorm, dirname+"/BndryNorm");
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        VisMF::Write(m_areafrac[idim], dirname+"/AreaFrac_"+std::to_string(idim));
+        VisMF::Write(m_facecent[idim], dirname+"/FaceCent_"+std::to_string(idim));
+    }
+}
+
+ChkptFileLevel::ChkptFileLevel (IndexSpace const* is, const std::string& dirname,
+                                const Geometry& geom, ChkptFileLevel const* fineLevel)
+    : Level(is, geom)
+{
+    BL_PROFILE("EB2::ChkptFileLevel()");
+
+    Vector<char> fileCharPtr;
+    ParallelDescriptor::ReadAndBcastFile(dirname+"/Header", fileCharPtr);
+    std::string fileCharPtrString(fileCharPtr.dataPtr());
+    std::istringstream hdr(fileCharPtrString, std::istringstream::in);
+
+    int ng;
+    hdr >> m_allregular >> m_ok >> m_ngrow >> ng;
+    for (BoxArray* ba : {&m_grids, &m_covered_grids}) {
+        long nboxes;
+        hdr >> nboxes;
+        if (nboxes > 0) {
+            ba->readFrom(hdr);
+        }
+    }
+    if (hdr.fail()) {
+        amrex::Abort("EB2::ChkptFileLevel: failed to read "+dirname+"/Header");
+    }
+
+    if (m_grids.empty()) return;
+
+    // The data are read by box index, so any DistributionMapping will do.
+    if (fineLevel != nullptr && amrex::match(m_grids, amrex::coarsen(fineLevel->boxArray(),2))) {
+        m_dmap = fineLevel->DistributionMap();
+    } else {
+        m_dmap = DistributionMapping(m_grids);
+    }
+
+    MFInfo mf_info;
+    mf_info.SetTag("EB2::Level");
+    m_levelset.define(amrex::convert(m_grids,IntVect::TheNodeVector()), m_dmap, 1, 0, mf_info);
+    m_cellflag.define(m_grids, m_dmap, 1, ng, mf_info);
+    m_volfrac.define(m_grids, m_dmap, 1, ng, mf_info);
+    m_centroid.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    m_bndryarea.define(m_grids, m_dmap, 1, ng, mf_info);
+    m_bndrycent.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    m_bndrynorm.define(m_grids, m_dmap, AMREX_SPACEDIM, ng, mf_info);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        m_areafrac[idim].define(amrex::convert(m_grids, IntVect::TheDimensionVector(idim)),
+                                m_dmap, 1, ng, mf_info);
+        m_facecent[idim].define(amrex::convert(m_grids, IntVect::TheDimensionVector(idim)),
+                                m_dmap, AMREX_SPACEDIM-1, ng, mf_info);
+    }
+
+    {
+        MultiFab cellflag(m_grids, m_dmap, 2, ng);
+        VisMF::Read(cellflag, dirname+"/CellFlag");
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(cellflag); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.fabbox();
+            auto const& dst = m_cellflag.array(mfi);
+            auto const& src = cellflag.const_array(mfi);
+            AMREX_HOST_DEVICE_FOR_3D(bx, i, j, k,
+            {
+                const uint32_t lo = static_cast<uint32_t>(src(i,j,k,0));
+                const uint32_t hi = static_cast<uint32_t>(src(i,j,k,1));
+                dst(i,j,k) = EBCellFlag((hi << 16) | lo);
+            });
+        }
+    }
+
+    VisMF::Read(m_levelset, dirname+"/LevelSet");
+    VisMF::Read(m_volfrac, dirname+"/VolFrac");
+    VisMF::Read(m_centroid, dirname+"/Centroid");
+    VisMF::Read(m_bndryarea, dirname+"/BndryArea");
+    VisMF::Read(m_bndrycent, dirname+"/BndryCent");
+    VisMF::Read(m_bndrynorm, dirname+"/BndryNorm");
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        VisMF::Read(m_areafrac[idim], dirname+"/AreaFrac_"+std::to_string(idim));
+        VisMF::Read(m_facecent[idim], dirname+"/FaceCent_"+std::to_string(idim));
+    }
+}
+
 }}
@@ -2,9 +2,15 @@
 #include <AMReX_EBDataCollection.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_MultiCutFab.H>
+#include <AMReX_SparseCutFab.H>
+#include <AMReX_ParmParse.H>
 
 #include <AMReX_EB2_Level.H>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace amrex {
 
 EBDataCollection::EBDataCollection (const EB2::Level& a_level,
@@ -19,6 +25,11 @@ EBDataCollection::EBDataCollection (const EB2::Level& a_level,
     // The BoxArray argument may not be cell-centered BoxArray.
     const BoxArray& a_ba = amrex::convert(a_ba_in, IntVect::TheZeroVector());
 
+    {
+        ParmParse pp("eb2");
+        pp.query("sparse_cut_data", m_sparse);
+    }
+
     if (m_support >= EBSupport::basic)
     {
         m_cellflags = new FabArray<EBCellFlagFab>(a_ba, a_dm, 1, m_ngrow[0], MFInfo(),
@@ -31,31 +42,42 @@ EBDataCollection::EBDataCollection (const EB2::Level& a_level,
         m_volfrac = new MultiFab(a_ba, a_dm, 1, m_ngrow[1], MFInfo(), FArrayBoxFactory());
         a_level.fillVolFrac(*m_volfrac, m_geom);
 
-        m_centroid = new MultiCutFab(a_ba, a_dm, AMREX_SPACEDIM, m_ngrow[1], *m_cellflags);
-        a_level.fillCentroid(*m_centroid, m_geom);
+        defineCutData(m_centroid, IndexType::TheCellType(), AMREX_SPACEDIM, m_ngrow[1], 0.0, 0.0);
+        a_level.fillCentroid(*m_centroid.dense, m_geom);
+        finishCutData(m_centroid);
     }
 
     if (m_support == EBSupport::full)
     {
         const int ng = m_ngrow[2];
 
-        m_bndrycent = new MultiCutFab(a_ba, a_dm, AMREX_SPACEDIM, ng, *m_cellflags);
-        a_level.fillBndryCent(*m_bndrycent, m_geom);
+        defineCutData(m_bndrycent, IndexType::TheCellType(), AMREX_SPACEDIM, ng, -1.0, -1.0);
+        a_level.fillBndryCent(*m_bndrycent.dense, m_geom);
+        finishCutData(m_bndrycent);
 
-        m_bndryarea = new MultiCutFab(a_ba, a_dm, 1, ng, *m_cellflags);
-        a_level.fillBndryArea(*m_bndryarea, m_geom);
+        defineCutData(m_bndryarea, IndexType::TheCellType(), 1, ng, 0.0, 0.0);
+        a_level.fillBndryArea(*m_bndryarea.dense, m_geom);
+        finishCutData(m_bndryarea);
 
-        m_bndrynorm = new MultiCutFab(a_ba, a_dm, AMREX_SPACEDIM, ng, *m_cellflags);
-        a_level.fillBndryNorm(*m_bndrynorm, m_geom);
+        defineCutData(m_bndrynorm, IndexType::TheCellType(), AMREX_SPACEDIM, ng, 0.0, 0.0);
+        a_level.fillBndryNorm(*m_bndrynorm.dense, m_geom);
+        finishCutData(m_bndrynorm);
 
+        Array<MultiCutFab*,AMREX_SPACEDIM> areafrac, facecent;
         for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
-            const BoxArray& faceba = amrex::convert(a_ba, IntVect::TheDimensionVector(idim));
-            m_areafrac[idim] = new MultiCutFab(faceba, a_dm, 1, ng, *m_cellflags);
-            m_facecent[idim] = new MultiCutFab(faceba, a_dm, AMREX_SPACEDIM-1, ng, *m_cellflags);
+            const IndexType typ(IntVect::TheDimensionVector(idim));
+            defineCutData(m_areafrac[idim], typ, 1, ng, 1.0, 0.0);
+            defineCutData(m_facecent[idim], typ, AMREX_SPACEDIM-1, ng, 0.0, 0.0);
+            areafrac[idim] = m_areafrac[idim].dense;
+            facecent[idim] = m_facecent[idim].dense;
         }
 
-        a_level.fillAreaFrac(m_areafrac, m_geom);
-        a_level.fillFaceCent(m_facecent, m_geom);
+        a_level.fillAreaFrac(areafrac, m_geom);
+        a_level.fillFaceCent(facecent, m_geom);
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            finishCutData(m_areafrac[idim]);
+            finishCutData(m_facecent[idim]);
+        }
     }
 }
 
@@ -63,16 +85,109 @@ EBDataCollection::~EBDataCollection ()
 {
     delete m_cellflags;
     delete m_volfrac;
-    delete m_centroid;
-    delete m_bndrycent;
-    delete m_bndrynorm;
-    delete m_bndryarea;
+    for (CutData* d : {&m_centroid, &m_bndrycent, &m_bndryarea, &m_bndrynorm}) {
+        delete d->dense;
+        delete d->sparse;
+    }
     for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
-        delete m_areafrac[idim];
-        delete m_facecent[idim];
+        delete m_areafrac[idim].dense;
+        delete m_areafrac[idim].sparse;
+        delete m_facecent[idim].dense;
+        delete m_facecent[idim].sparse;
+    }
+}
+
+void
+EBDataCollection::defineCutData (CutData& d, IndexType typ, int ncomp, int ngrow,
+                                 Real regular_value, Real covered_value)
+{
+    d.typ = typ;
+    d.ncomp = ncomp;
+    d.ngrow = ngrow;
+    d.regular_value = regular_value;
+    d.covered_value = covered_value;
+    d.dense = new MultiCutFab(amrex::convert(m_cellflags->boxArray(), typ),
+                              m_cellflags->DistributionMap(), ncomp, ngrow, *m_cellflags);
+}
+
+void
+EBDataCollection::finishCutData (CutData& d)
+{
+    if (m_sparse) {
+        getSparse(d);
+        delete d.dense;
+        d.dense = nullptr;
     }
 }
 
+const MultiCutFab&
+EBDataCollection::getDense (CutData& d) const
+{
+    std::call_once(d.dense_flag, [&] ()
+    {
+        if (d.dense == nullptr) {
+#ifdef _OPENMP
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!omp_in_parallel(),
+                "EBDataCollection: dense cut cell data first asked for in a parallel region");
+#endif
+            AMREX_ASSERT(d.sparse != nullptr);
+            d.dense = new MultiCutFab(amrex::convert(m_cellflags->boxArray(), d.typ),
+                                      m_cellflags->DistributionMap(), d.ncomp, d.ngrow,
+                                      *m_cellflags);
+            d.sparse->scatter(*d.dense);
+        }
+    });
+    return *d.dense;
+}
+
+const MultiSparseCutFab&
+EBDataCollection::getSparse (CutData& d) const
+{
+    std::call_once(d.sparse_flag, [&] ()
+    {
+        if (d.sparse == nullptr) {
+#ifdef _OPENMP
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!omp_in_parallel(),
+                "EBDataCollection: sparse cut cell data first asked for in a parallel region");
+#endif
+            AMREX_ASSERT(d.dense != nullptr);
+            std::call_once(m_index_maps_flag, [&] ()
+            {
+                m_index_maps = MultiSparseCutFab::makeIndexMaps(*m_cellflags);
+            });
+            d.sparse = new MultiSparseCutFab(*m_cellflags, d.typ, d.ncomp, d.regular_value,
+                                             d.covered_value, m_index_maps);
+            d.sparse->gather(*d.dense);
+        }
+    });
+    return *d.sparse;
+}
+
+EBCutData
+EBDataCollection::getData (CutData& d) const
+{
+    if (m_sparse) {
+        return EBCutData(nullptr, &getSparse(d), m_cellflags, d.ngrow);
+    } else {
+        return EBCutData(&getDense(d), nullptr, m_cellflags, d.ngrow);
+    }
+}
+
+const FArrayBox&
+EBCutData::fab (const MFIter& mfi, const Box& region, FArrayBox& tmp) const
+{
+    if (m_dense) {
+        return (*m_dense)[mfi];
+    }
+    AMREX_ASSERT(m_sparse != nullptr && m_sparse->ok(mfi));
+    const IndexType typ = m_sparse->ixType();
+    const Box& vbx = m_cellflags->boxArray()[mfi.index()];
+    const Box& bx = amrex::convert(region & amrex::grow(vbx,m_ngrow), typ);
+    tmp.resize(bx, m_sparse->nComp());
+    m_sparse->scatter(mfi, tmp);
+    return tmp;
+}
+
 const FabArray<EBCellFlagFab>&
 EBDataCollection::getMultiEBCellFlagFab () const
 {
@@ -90,43 +205,115 @@ EBDataCollection::getVolFrac () const
 const MultiCutFab&
 EBDataCollection::getCentroid () const
 {
-    AMREX_ASSERT(m_centroid != nullptr);
-    return *m_centroid;
+    return getDense(m_centroid);
 }
 
 const MultiCutFab&
 EBDataCollection::getBndryCent () const
 {
-    AMREX_ASSERT(m_bndrycent != nullptr);
-    return *m_bndrycent;
+    return getDense(m_bndrycent);
 }
 
 const MultiCutFab&
 EBDataCollection::getBndryArea () const
 {
-    AMREX_ASSERT(m_bndryarea != nullptr);
-    return *m_bndryarea;
+    return getDense(m_bndryarea);
 }
 
 Array<const MultiCutFab*, AMREX_SPACEDIM>
 EBDataCollection::getAreaFrac () const
 {
-    AMREX_ASSERT(m_areafrac[0] != nullptr);
-    return {AMREX_D_DECL(m_areafrac[0], m_areafrac[1], m_areafrac[2])};
+    return {AMREX_D_DECL(&getDense(m_areafrac[0]), &getDense(m_areafrac[1]),
+                         &getDense(m_areafrac[2]))};
 }
 
 Array<const MultiCutFab*, AMREX_SPACEDIM>
 EBDataCollection::getFaceCent () const
 {
-    AMREX_ASSERT(m_facecent[0] != nullptr);
-    return {AMREX_D_DECL(m_facecent[0], m_facecent[1], m_facecent[2])};
+    return {AMREX_D_DECL(&getDense(m_facecent[0]), &getDense(m_facecent[1]),
+                         &getDense(m_facecent[2]))};
 }
 
 const MultiCutFab&
 EBDataCollection::getBndryNormal () const
 {
-    AMREX_ASSERT(m_bndrynorm != nullptr);
-    return *m_bndrynorm;
+    return getDense(m_bndrynorm);
+}
+
+const MultiSparseCutFab&
+EBDataCollection::getSparseCentroid () const
+{
+    return getSparse(m_centroid);
+}
+
+const MultiSparseCutFab&
+EBDataCollection::getSparseBndryCent () const
+{
+    return getSparse(m_bndrycent);
+}
+
+const MultiSparseCutFab&
+EBDataCollection::getSparseBndryArea () const
+{
+    return getSparse(m_bndryarea);
+}
+
+const MultiSparseCutFab&
+EBDataCollection::getSparseBndryNormal () const
+{
+    return getSparse(m_bndrynorm);
+}
+
+Array<const MultiSparseCutFab*, AMREX_SPACEDIM>
+EBDataCollection::getSparseAreaFrac () const
+{
+    return {AMREX_D_DECL(&getSparse(m_areafrac[0]), &getSparse(m_areafrac[1]),
+                         &getSparse(m_areafrac[2]))};
+}
+
+Array<const MultiSparseCutFab*, AMREX_SPACEDIM>
+EBDataCollection::getSparseFaceCent () const
+{
+    return {AMREX_D_DECL(&getSparse(m_facecent[0]), &getSparse(m_facecent[1]),
+                         &getSparse(m_facecent[2]))};
+}
+
+EBCutData
+EBDataCollection::getCentroidData () const
+{
+    return getData(m_centroid);
+}
+
+EBCutData
+EBDataCollection::getBndryCentData () const
+{
+    return getData(m_bndrycent);
+}
+
+EBCutData
+EBDataCollection::getBndryAreaData () const
+{
+    return getData(m_bndryarea);
+}
+
+EBCutData
+EBDataCollection::getBndryNormalData () const
+{
+    return getData(m_bndrynorm);
+}
+
+Array<EBCutData, AMREX_SPACEDIM>
+EBDataCollection::getAreaFracData () const
+{
+    return {AMREX_D_DECL(getData(m_areafrac[0]), getData(m_areafrac[1]),
+                         getData(m_areafrac[2]))};
+}
+
+Array<EBCutData, AMREX_SPACEDIM>
+EBDataCollection::getFaceCentData () const
+{
+    return {AMREX_D_DECL(getData(m_facecent[0]), getData(m_facecent[1]),
+                         getData(m_facecent[2]))};
 }
 
 }
@@ -405,7 +405,7 @@ void EB_average_down_faces (const Array<const MultiFab*,AMREX_SPACEDIM>& fine,
         Dim3 dratio = ratio.dim3();
 
         const auto& factory = dynamic_cast<EBFArrayBoxFactory const&>((*fine[0]).Factory());
-        const auto&  aspect = factory.getAreaFrac();
+        const auto&  aspect = factory.getAreaFracData();
 
         if (isMFIterSafe(*fine[0], *crse[0]))
         {
@@ -431,7 +431,9 @@ void EB_average_down_faces (const Array<const MultiFab*,AMREX_SPACEDIM>& fine,
                     }
                     else
                     {
-                        Array4<Real const> const& ap = aspect[n]->const_array(mfi);
+                        FArrayBox aptmp;
+                        const Box& fbx = amrex::refine(amrex::convert(tbx,IntVect::TheZeroVector()),ratio);
+                        Array4<Real const> const& ap = aspect[n].fab(mfi,fbx,aptmp).const_array();
                         if (n == 0) {
                             AMREX_HOST_DEVICE_FOR_3D(tbx,i,j,k,
                             {
@@ -493,7 +495,7 @@ void EB_average_down_boundaries (const MultiFab& fine, MultiFab& crse,
 
         const auto& factory = dynamic_cast<EBFArrayBoxFactory const&>(fine.Factory());
         const auto& flags = factory.getMultiEBCellFlagFab();
-        const auto& barea = factory.getBndryArea();
+        const auto& barea = factory.getBndryAreaData();
 
         if (isMFIterSafe(fine, crse))
         {
@@ -514,7 +516,8 @@ void EB_average_down_boundaries (const MultiFab& fine, MultiFab& crse,
                     });
                 } else {
                     Array4<Real const> const& fa = fine.const_array(mfi);
-                    Array4<Real const> const& ba = barea.const_array(mfi);
+                    FArrayBox batmp;
+                    Array4<Real const> const& ba = barea.fab(mfi,amrex::refine(tbx,ratio),batmp).const_array();
                     AMREX_HOST_DEVICE_FOR_3D(tbx,i,j,k,
                     {
                         eb_avgdown_boundaries(i,j,k,fa,0,ca,0,ba,dratio,ncomp);
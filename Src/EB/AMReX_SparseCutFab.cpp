@@ -0,0 +1,316 @@
+
+#include <AMReX_SparseCutFab.H>
+#include <AMReX_MultiCutFab.H>
+#include <AMReX_MultiFab.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace amrex {
+
+CutCellIndexMap::CutCellIndexMap (const EBCellFlagFab& flag)
+{
+    const Box& fbx = flag.box();
+    Box bx = fbx;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        bx.growHi(idim,1);
+    }
+
+    // The map is built once, on the host.
+#ifdef AMREX_USE_GPU
+    EBCellFlagFab hflag(fbx, 1, The_Pinned_Arena());
+    Gpu::dtoh_memcpy(hflag.dataPtr(), flag.dataPtr(), flag.nBytes());
+    BaseFab<int> hindex(bx, 1, The_Pinned_Arena());
+#else
+    const EBCellFlagFab& hflag = flag;
+    BaseFab<int>& hindex = m_index;
+    m_index.resize(bx, 1);
+#endif
+
+    auto const& fa = hflag.const_array();
+    auto const& ia = hindex.array();
+    auto is_cut = [&] (int i, int j, int k) -> bool
+    {
+        if (!fa.contains(i,j,k)) return false;
+        const EBCellFlag f = fa(i,j,k);
+        return !f.isRegular() && !f.isCovered();
+    };
+
+    m_nstored = 0;
+    amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+    {
+        bool stored = is_cut(i,j,k);
+        AMREX_D_TERM(stored = stored || is_cut(i-1,j,k);,
+                     stored = stored || is_cut(i,j-1,k);,
+                     stored = stored || is_cut(i,j,k-1););
+        ia(i,j,k) = stored ? m_nstored++ : -1;
+    });
+
+    const Box cbx(IntVect(0), IntVect(AMREX_D_DECL(std::max(m_nstored,1)-1,0,0)));
+#ifdef AMREX_USE_GPU
+    BaseFab<int> hcells(cbx, AMREX_SPACEDIM, The_Pinned_Arena());
+#else
+    BaseFab<int>& hcells = m_cells;
+    m_cells.resize(cbx, AMREX_SPACEDIM);
+#endif
+    auto const& ca = hcells.array();
+    amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+    {
+        const int m = ia(i,j,k);
+        if (m >= 0) {
+            AMREX_D_TERM(ca(m,0,0,0) = i;,
+                         ca(m,0,0,1) = j;,
+                         ca(m,0,0,2) = k;);
+        }
+    });
+
+#ifdef AMREX_USE_GPU
+    m_index.resize(bx, 1);
+    Gpu::htod_memcpy(m_index.dataPtr(), hindex.dataPtr(), hindex.nBytes());
+    m_cells.resize(cbx, AMREX_SPACEDIM);
+    Gpu::htod_memcpy(m_cells.dataPtr(), hcells.dataPtr(), hcells.nBytes());
+#endif
+}
+
+MultiSparseCutFab::MultiSparseCutFab (const FabArray<EBCellFlagFab>& cellflags, IndexType typ,
+                                      int ncomp, Real regular_value, Real covered_value,
+                                      std::shared_ptr<const IndexMaps> index_maps)
+{
+    define(cellflags, typ, ncomp, regular_value, covered_value, std::move(index_maps));
+}
+
+void
+MultiSparseCutFab::define (const FabArray<EBCellFlagFab>& cellflags, IndexType typ,
+                           int ncomp, Real regular_value, Real covered_value,
+                           std::shared_ptr<const IndexMaps> index_maps)
+{
+#ifdef AMREX_DEBUG
+    int nnodal = 0;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (typ.nodeCentered(idim)) ++nnodal;
+    }
+    AMREX_ASSERT_WITH_MESSAGE(nnodal <= 1, "MultiSparseCutFab: only cell and face data are supported");
+#endif
+
+    m_cellflags = &cellflags;
+    m_index_maps = index_maps ? std::move(index_maps) : makeIndexMaps(cellflags);
+    m_typ = typ;
+    m_ncomp = ncomp;
+    m_regular_value = regular_value;
+    m_covered_value = covered_value;
+
+    AMREX_ASSERT(static_cast<int>(m_index_maps->size()) == cellflags.local_size());
+
+    m_data.clear();
+    m_data.resize(cellflags.local_size());
+    for (MFIter mfi(cellflags, MFItInfo().DisableDeviceSync()); mfi.isValid(); ++mfi)
+    {
+        if (ok(mfi)) {
+            const int n = indexMap(mfi).numStored();
+            const Box bx(IntVect(0), IntVect(AMREX_D_DECL(std::max(n,1)-1,0,0)));
+            m_data[mfi.LocalIndex()].resize(bx, ncomp);
+        }
+    }
+}
+
+std::shared_ptr<const MultiSparseCutFab::IndexMaps>
+MultiSparseCutFab::makeIndexMaps (const FabArray<EBCellFlagFab>& cellflags)
+{
+    BL_PROFILE("MultiSparseCutFab::makeIndexMaps()");
+    std::shared_ptr<IndexMaps> maps = std::make_shared<IndexMaps>();
+    maps->reserve(cellflags.local_size());
+    for (int li = 0, N = cellflags.local_size(); li < N; ++li)
+    {
+        const EBCellFlagFab& flag = cellflags[cellflags.IndexArray()[li]];
+        if (flag.getType() == FabType::singlevalued) {
+            maps->emplace_back(flag);
+        } else {
+            maps->emplace_back();
+        }
+    }
+    return maps;
+}
+
+bool
+MultiSparseCutFab::ok (const MFIter& mfi) const noexcept
+{
+    return (*m_cellflags)[mfi].getType() == FabType::singlevalued;
+}
+
+SparseArray4<Real>
+MultiSparseCutFab::array (const MFIter& mfi) noexcept
+{
+    AMREX_ASSERT(ok(mfi));
+    const CutCellIndexMap& imap = indexMap(mfi);
+    int fdir = -1;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (m_typ.nodeCentered(idim)) fdir = idim;
+    }
+    return SparseArray4<Real>(m_data[mfi.LocalIndex()].dataPtr(), imap.index(), imap.cells(),
+                              (*m_cellflags)[mfi].const_array(), imap.numStored(), m_ncomp,
+                              fdir, m_regular_value, m_covered_value);
+}
+
+SparseArray4<Real const>
+MultiSparseCutFab::array (const MFIter& mfi) const noexcept
+{
+    return const_array(mfi);
+}
+
+SparseArray4<Real const>
+MultiSparseCutFab::const_array (const MFIter& mfi) const noexcept
+{
+    return SparseArray4<Real const>(const_cast<MultiSparseCutFab*>(this)->array(mfi));
+}
+
+void
+MultiSparseCutFab::setVal (Real val)
+{
+    for (MFIter mfi(*m_cellflags); mfi.isValid(); ++mfi)
+    {
+        if (ok(mfi)) {
+            m_data[mfi.LocalIndex()].setVal(val);
+        }
+    }
+}
+
+void
+MultiSparseCutFab::gather (const MFIter& mfi, const FArrayBox& src)
+{
+    if (!ok(mfi)) return;
+    AMREX_ASSERT(src.box().ixType() == m_typ && src.nComp() >= m_ncomp);
+    const auto& a = array(mfi);
+    const auto& s = src.const_array();
+    const Box& sbx = src.box();
+    const int ncomp = m_ncomp;
+    amrex::ParallelFor(a.nstored, [=] AMREX_GPU_DEVICE (int m) noexcept
+    {
+        const IntVect& iv = a.cell(m);
+        if (sbx.contains(iv)) {
+            for (int n = 0; n < ncomp; ++n) {
+                a.data(m,n) = s(iv,n);
+            }
+        }
+    });
+}
+
+void
+MultiSparseCutFab::scatter (const MFIter& mfi, FArrayBox& dst) const
+{
+    AMREX_ASSERT(ok(mfi));
+    AMREX_ASSERT(dst.box().ixType() == m_typ && dst.nComp() >= m_ncomp);
+    const auto& a = const_array(mfi);
+    const auto& d = dst.array();
+    const int ncomp = m_ncomp;
+    const Box& bx = dst.box();
+    // Fill from the cell flags first, and then overwrite the stored
+    // entries, which are few, rather than look up every entry.
+    Box cbx = amrex::convert(bx, IntVect::TheZeroVector());
+    if (a.fdir >= 0) cbx.growLo(a.fdir, 1);
+    if ((*m_cellflags)[mfi].box().contains(cbx))
+    {
+        // All the cells needed are in the flag fab, so skip the bounds checks.
+        const auto& flag = a.flag;
+        const Real regular_value = m_regular_value;
+        const Real covered_value = m_covered_value;
+        const int di = (a.fdir == 0) ? 1 : 0;
+        const int dj = (a.fdir == 1) ? 1 : 0;
+        const int dk = (a.fdir == 2) ? 1 : 0;
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            const bool covered = flag(i,j,k).isCovered() || flag(i-di,j-dj,k-dk).isCovered();
+            const Real v = covered ? covered_value : regular_value;
+            for (int n = 0; n < ncomp; ++n) {
+                d(i,j,k,n) = v;
+            }
+        });
+    }
+    else
+    {
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            const Real v = a.unstoredValue(i,j,k);
+            for (int n = 0; n < ncomp; ++n) {
+                d(i,j,k,n) = v;
+            }
+        });
+    }
+    amrex::ParallelFor(a.nstored,
+    [=] AMREX_GPU_DEVICE (int m) noexcept
+    {
+        const IntVect iv = a.cell(m);
+        if (bx.contains(iv)) {
+            for (int n = 0; n < ncomp; ++n) {
+                d(iv,n) = a.data(m,n);
+            }
+        }
+    });
+}
+
+void
+MultiSparseCutFab::gather (const MultiCutFab& src)
+{
+    BL_PROFILE("MultiSparseCutFab::gather()");
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(src.data()); mfi.isValid(); ++mfi)
+    {
+        if (ok(mfi)) {
+            gather(mfi, src[mfi]);
+        }
+    }
+}
+
+void
+MultiSparseCutFab::scatter (MultiCutFab& dst) const
+{
+    BL_PROFILE("MultiSparseCutFab::scatter()");
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(dst.data()); mfi.isValid(); ++mfi)
+    {
+        if (ok(mfi)) {
+            scatter(mfi, dst[mfi]);
+        }
+    }
+}
+
+MultiFab
+MultiSparseCutFab::ToMultiFab (int ngrow) const
+{
+    AMREX_ASSERT(ngrow <= m_cellflags->nGrow());
+    MultiFab mf(amrex::convert(m_cellflags->boxArray(), m_typ),
+                m_cellflags->DistributionMap(), m_ncomp, ngrow);
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        auto t = (*m_cellflags)[mfi].getType();
+        if (t == FabType::singlevalued) {
+            scatter(mfi, mf[mfi]);
+        } else if (t == FabType::regular) {
+            mf[mfi].setVal(m_regular_value);
+        } else {
+            mf[mfi].setVal(m_covered_value);
+        }
+    }
+    return mf;
+}
+
+long
+MultiSparseCutFab::nBytes () const noexcept
+{
+    long r = 0;
+    for (const auto& fab : m_data) {
+        r += fab.nBytes();
+    }
+    return r;
+}
+
+}
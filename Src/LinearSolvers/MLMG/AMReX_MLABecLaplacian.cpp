@@ -207,15 +207,57 @@ MLABecLaplacian::prepareForSolve ()
     m_needs_update = false;
 }
 
+void
+MLABecLaplacian::prepareMixedPrecision ()
+{
+    BL_PROFILE("MLABecLaplacian::prepareMixedPrecision()");
+
+    const int ncomp = getNComp();
+    m_a_coeffs_f.resize(m_num_amr_levels);
+    m_b_coeffs_f.resize(m_num_amr_levels);
+    for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev)
+    {
+        m_a_coeffs_f[amrlev].resize(m_num_mg_levels[amrlev]);
+        m_b_coeffs_f[amrlev].resize(m_num_mg_levels[amrlev]);
+        for (int mglev = 1; mglev < m_num_mg_levels[amrlev]; ++mglev)
+        {
+            const MultiFab& a = m_a_coeffs[amrlev][mglev];
+            m_a_coeffs_f[amrlev][mglev].define(a.boxArray(), a.DistributionMap(), a.nComp(), 0);
+            copyConvert(m_a_coeffs_f[amrlev][mglev], a, a.nComp());
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+            {
+                const MultiFab& b = m_b_coeffs[amrlev][mglev][idim];
+                m_b_coeffs_f[amrlev][mglev][idim].define(b.boxArray(), b.DistributionMap(), ncomp, 0);
+                copyConvert(m_b_coeffs_f[amrlev][mglev][idim], b, ncomp);
+            }
+        }
+    }
+}
+
 void
 MLABecLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& in) const
 {
     BL_PROFILE("MLABecLaplacian::Fapply()");
+    adotx(amrlev, mglev, out, in, m_a_coeffs[amrlev][mglev],
+          amrex::GetArrOfConstPtrs(m_b_coeffs[amrlev][mglev]));
+}
 
-    const MultiFab& acoef = m_a_coeffs[amrlev][mglev];
-    AMREX_D_TERM(const MultiFab& bxcoef = m_b_coeffs[amrlev][mglev][0];,
-                 const MultiFab& bycoef = m_b_coeffs[amrlev][mglev][1];,
-                 const MultiFab& bzcoef = m_b_coeffs[amrlev][mglev][2];);
+void
+MLABecLaplacian::FapplyF (int amrlev, int mglev, FloatMultiFab& out, const FloatMultiFab& in) const
+{
+    BL_PROFILE("MLABecLaplacian::FapplyF()");
+    adotx(amrlev, mglev, out, in, m_a_coeffs_f[amrlev][mglev],
+          amrex::GetArrOfConstPtrs(m_b_coeffs_f[amrlev][mglev]));
+}
+
+template <class MF>
+void
+MLABecLaplacian::adotx (int amrlev, int mglev, MF& out, const MF& in, const MF& acoef,
+                        Array<MF const*,AMREX_SPACEDIM> const& bcoef) const
+{
+    AMREX_D_TERM(const MF& bxcoef = *bcoef[0];,
+                 const MF& bycoef = *bcoef[1];,
+                 const MF& bzcoef = *bcoef[2];);
 
     const auto dxinv = m_geom[amrlev][mglev].InvCellSizeArray();
 
@@ -230,9 +272,9 @@ MLABecLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
     for (MFIter mfi(out, TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
         const Box& bx = mfi.tilebox();
-        const auto& xfab = in.array(mfi);
+        const auto& xfab = in.const_array(mfi);
         const auto& yfab = out.array(mfi);
-        const auto& afab = acoef.array(mfi);
+        const auto& afab = acoef.const_array(mfi);
         AMREX_D_TERM(const auto& bxfab = bxcoef.array(mfi);,
                      const auto& byfab = bycoef.array(mfi);,
                      const auto& bzfab = bzcoef.array(mfi););
@@ -286,11 +328,63 @@ void
 MLABecLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs, int redblack) const
 {
     BL_PROFILE("MLABecLaplacian::Fsmooth()");
+    gsrb(amrlev, mglev, sol, rhs, m_a_coeffs[amrlev][mglev],
+         amrex::GetArrOfConstPtrs(m_b_coeffs[amrlev][mglev]), redblack, GSRBPass::Single);
+}
 
-    const MultiFab& acoef = m_a_coeffs[amrlev][mglev];
-    AMREX_D_TERM(const MultiFab& bxcoef = m_b_coeffs[amrlev][mglev][0];,
-                 const MultiFab& bycoef = m_b_coeffs[amrlev][mglev][1];,
-                 const MultiFab& bzcoef = m_b_coeffs[amrlev][mglev][2];);
+void
+MLABecLaplacian::FsmoothF (int amrlev, int mglev, FloatMultiFab& sol, const FloatMultiFab& rhs,
+                           int redblack) const
+{
+    BL_PROFILE("MLABecLaplacian::FsmoothF()");
+    gsrb(amrlev, mglev, sol, rhs, m_a_coeffs_f[amrlev][mglev],
+         amrex::GetArrOfConstPtrs(m_b_coeffs_f[amrlev][mglev]), redblack, GSRBPass::Single);
+}
+
+//
+// The fused smoother does the red sweep and the black sweep away from the
+// box boundaries in one pass over each box, plane by plane.  The black
+// cells within shell_width of the boundaries are done after the ghost cells
+// have been filled again, and so are those on the sides of the tiles.  The
+// ghost cells only depend on the cells in the shell, so the result is the
+// same as that of two separate sweeps.
+//
+void
+MLABecLaplacian::smooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
+                         bool skip_fillboundary) const
+{
+    if (!m_fused_smooth || Gpu::inLaunchRegion()) {
+        MLCellABecLap::smooth(amrlev, mglev, sol, rhs, skip_fillboundary);
+        return;
+    }
+
+    BL_PROFILE("MLABecLaplacian::smooth()");
+
+    applyBC(amrlev, mglev, sol, BCMode::Homogeneous, StateMode::Solution,
+            nullptr, skip_fillboundary);
+#ifdef AMREX_SOFT_PERF_COUNTERS
+    perf_counters.smooth(sol);
+#endif
+    gsrb(amrlev, mglev, sol, rhs, m_a_coeffs[amrlev][mglev],
+         amrex::GetArrOfConstPtrs(m_b_coeffs[amrlev][mglev]), 0, GSRBPass::FusedInterior);
+
+    applyBC(amrlev, mglev, sol, BCMode::Homogeneous, StateMode::Solution);
+#ifdef AMREX_SOFT_PERF_COUNTERS
+    perf_counters.smooth(sol);
+#endif
+    gsrb(amrlev, mglev, sol, rhs, m_a_coeffs[amrlev][mglev],
+         amrex::GetArrOfConstPtrs(m_b_coeffs[amrlev][mglev]), 1, GSRBPass::Shell);
+}
+
+template <class MF>
+void
+MLABecLaplacian::gsrb (int amrlev, int mglev, MF& sol, const MF& rhs, const MF& acoef,
+                       Array<MF const*,AMREX_SPACEDIM> const& bcoef, int redblack,
+                       GSRBPass pass) const
+{
+    AMREX_D_TERM(const MF& bxcoef = *bcoef[0];,
+                 const MF& bycoef = *bcoef[1];,
+                 const MF& bzcoef = *bcoef[2];);
     const auto& undrrelxr = m_undrrelxr[amrlev][mglev];
     const auto& maskvals  = m_maskvals [amrlev][mglev];
 
@@ -325,8 +419,18 @@ MLABecLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
                  const Real dhz = m_b_scalar/(h[2]*h[2]));
     const Real alpha = m_a_scalar;
 
+    // Cells further than this from the boundary are not used to fill ghost cells.
+    const int shell_width = std::max(1, maxorder-1);
+
+    // The fused passes sweep plane by plane in the last direction, so their
+    // tiles are not split in that direction.
+    constexpr int d = AMREX_SPACEDIM-1;
     MFItInfo mfi_info;
-    if (Gpu::notInLaunchRegion()) mfi_info.EnableTiling().SetDynamic(true);
+    if (Gpu::notInLaunchRegion()) {
+        IntVect tile_size = FabArrayBase::mfiter_tile_size;
+        if (pass != GSRBPass::Single) tile_size[d] = 1024000;
+        mfi_info.EnableTiling(tile_size).SetDynamic(true);
+    }
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
@@ -347,8 +451,8 @@ MLABecLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
 	const Box& tbx = mfi.tilebox();
         const Box& vbx = mfi.validbox();
         const auto& solnfab = sol.array(mfi);
-        const auto& rhsfab  = rhs.array(mfi);
-        const auto& afab    = acoef.array(mfi);
+        const auto& rhsfab  = rhs.const_array(mfi);
+        const auto& afab    = acoef.const_array(mfi);
 
         AMREX_D_TERM(const auto& bxfab = bxcoef.array(mfi);,
                      const auto& byfab = bycoef.array(mfi);,
@@ -365,34 +469,67 @@ MLABecLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
 #endif
 #endif
 
-#if (AMREX_SPACEDIM == 1)
-        AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( tbx, thread_box,
+        if (pass == GSRBPass::Single)
         {
-            abec_gsrb(thread_box, solnfab, rhsfab, alpha, dhx,
-                      afab, bxfab,
-                      f0fab, m0,
-                      f1fab, m1,
-                      vbx, nc, redblack);
-        });
+#if (AMREX_SPACEDIM == 1)
+            AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( tbx, thread_box,
+            {
+                abec_gsrb(thread_box, solnfab, rhsfab, alpha, dhx,
+                          afab, bxfab,
+                          f0fab, m0,
+                          f1fab, m1,
+                          vbx, nc, redblack);
+            });
 #endif
 
 #if (AMREX_SPACEDIM == 2)
-        AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( tbx, thread_box,
+            AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( tbx, thread_box,
+            {
+                abec_gsrb(thread_box, solnfab, rhsfab, alpha, dhx, dhy,
+                          afab, bxfab, byfab,
+                          f0fab, m0,
+                          f1fab, m1,
+                          f2fab, m2,
+                          f3fab, m3,
+                          vbx, nc, redblack);
+            });
+#endif
+
+#if (AMREX_SPACEDIM == 3)
+            AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( tbx, thread_box,
+            {
+                abec_gsrb(thread_box, solnfab, rhsfab, alpha, dhx, dhy, dhz,
+                          afab, bxfab, byfab, bzfab,
+                          f0fab, m0,
+                          f1fab, m1,
+                          f2fab, m2,
+                          f3fab, m3,
+                          f4fab, m4,
+                          f5fab, m5,
+                          vbx, nc, redblack);
+            });
+#endif
+            continue;
+        }
+
+        auto sweep = [&] (Box const& bx, int rb)
         {
-            abec_gsrb(thread_box, solnfab, rhsfab, alpha, dhx, dhy,
+#if (AMREX_SPACEDIM == 1)
+            abec_gsrb(bx, solnfab, rhsfab, alpha, dhx,
+                      afab, bxfab,
+                      f0fab, m0,
+                      f1fab, m1,
+                      vbx, nc, rb);
+#elif (AMREX_SPACEDIM == 2)
+            abec_gsrb(bx, solnfab, rhsfab, alpha, dhx, dhy,
                       afab, bxfab, byfab,
                       f0fab, m0,
                       f1fab, m1,
                       f2fab, m2,
                       f3fab, m3,
-                      vbx, nc, redblack);
-        });
-#endif
-
-#if (AMREX_SPACEDIM == 3)
-        AMREX_LAUNCH_HOST_DEVICE_LAMBDA ( tbx, thread_box,
-        {
-            abec_gsrb(thread_box, solnfab, rhsfab, alpha, dhx, dhy, dhz,
+                      vbx, nc, rb);
+#else
+            abec_gsrb(bx, solnfab, rhsfab, alpha, dhx, dhy, dhz,
                       afab, bxfab, byfab, bzfab,
                       f0fab, m0,
                       f1fab, m1,
@@ -400,9 +537,49 @@ MLABecLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
                       f3fab, m3,
                       f4fab, m4,
                       f5fab, m5,
-                      vbx, nc, redblack);
-        });
+                      vbx, nc, rb);
 #endif
+        };
+
+        // The black cells done in the fused pass.  They are away from the
+        // box boundaries, and from the sides of the tile, where the red
+        // neighbors belong to other tiles, which may not be done yet.
+        Box fused = tbx;
+        for (int idim = 0; idim < d; ++idim) {
+            fused.grow(idim, -1);
+        }
+        fused &= amrex::grow(vbx, -shell_width);
+
+        if (pass == GSRBPass::FusedInterior)
+        {
+            // Red on plane k, then black on plane k-1, whose red neighbors
+            // are all done by then.  Only a few planes are in cache at a time.
+            const int klo = tbx.smallEnd(d);
+            const int khi = tbx.bigEnd(d);
+            for (int k = klo; k <= khi+1; ++k)
+            {
+                if (k <= khi) {
+                    Box plane = tbx;
+                    plane.setRange(d, k);
+                    sweep(plane, redblack);
+                }
+                if (fused.ok() && k-1 >= fused.smallEnd(d) && k-1 <= fused.bigEnd(d)) {
+                    Box plane = fused;
+                    plane.setRange(d, k-1);
+                    sweep(plane, 1-redblack);
+                }
+            }
+        }
+        else
+        {
+            if (fused.ok()) {
+                for (const Box& b : amrex::boxDiff(tbx, fused)) {
+                    sweep(b, redblack);
+                }
+            } else {
+                sweep(tbx, redblack);
+            }
+        }
     }
 }
 
@@ -0,0 +1,846 @@
+
+#include <algorithm>
+#include <cmath>
+
+#include <AMReX_MLAMGSolver.H>
+#include <AMReX_iMultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_BLProfiler.H>
+#include <AMReX_Loop.H>
+
+namespace amrex {
+
+namespace {
+
+using Matrix = MLAMGSolver::Matrix;
+
+// y = A x
+void spmv (const Matrix& A, const Vector<Real>& x, Vector<Real>& y)
+{
+    const int n = A.nrows;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < n; ++i) {
+        Real s = 0.0;
+        for (int p = A.ptr[i]; p < A.ptr[i+1]; ++p) {
+            s += A.val[p] * x[A.col[p]];
+        }
+        y[i] = s;
+    }
+}
+
+// r = b - A x
+void residual (const Matrix& A, const Vector<Real>& x, const Vector<Real>& b, Vector<Real>& r)
+{
+    const int n = A.nrows;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < n; ++i) {
+        Real s = b[i];
+        for (int p = A.ptr[i]; p < A.ptr[i+1]; ++p) {
+            s -= A.val[p] * x[A.col[p]];
+        }
+        r[i] = s;
+    }
+}
+
+Real dot (const Vector<Real>& x, const Vector<Real>& y)
+{
+    const int n = x.size();
+    Real s = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:s)
+#endif
+    for (int i = 0; i < n; ++i) {
+        s += x[i]*y[i];
+    }
+    return s;
+}
+
+Real norminf (const Vector<Real>& x)
+{
+    const int n = x.size();
+    Real s = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(max:s)
+#endif
+    for (int i = 0; i < n; ++i) {
+        s = std::max(s, std::abs(x[i]));
+    }
+    return s;
+}
+
+// y = a*x + b*y
+void axpby (Real a, const Vector<Real>& x, Real b, Vector<Real>& y)
+{
+    const int n = x.size();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < n; ++i) {
+        y[i] = a*x[i] + b*y[i];
+    }
+}
+
+// The columns of the result are sorted.
+Matrix transpose (const Matrix& A)
+{
+    Matrix T;
+    T.nrows = A.ncols;
+    T.ncols = A.nrows;
+    T.ptr.assign(T.nrows+1, 0);
+    const int nnz = A.ptr[A.nrows];
+    for (int p = 0; p < nnz; ++p) {
+        ++T.ptr[A.col[p]+1];
+    }
+    for (int i = 0; i < T.nrows; ++i) {
+        T.ptr[i+1] += T.ptr[i];
+    }
+    T.col.resize(nnz);
+    T.val.resize(nnz);
+    Vector<int> pos(T.ptr.begin(), T.ptr.end()-1);
+    for (int i = 0; i < A.nrows; ++i) {
+        for (int p = A.ptr[i]; p < A.ptr[i+1]; ++p) {
+            const int q = pos[A.col[p]]++;
+            T.col[q] = i;
+            T.val[q] = A.val[p];
+        }
+    }
+    return T;
+}
+
+// C = A B.  The columns of the result are sorted.
+Matrix multiply (const Matrix& A, const Matrix& B)
+{
+    Matrix C;
+    C.nrows = A.nrows;
+    C.ncols = B.ncols;
+    C.ptr.assign(C.nrows+1, 0);
+    Vector<int> marker(B.ncols, -1);
+    Vector<Real> acc(B.ncols, 0.0);
+    Vector<int> cols;
+    for (int i = 0; i < A.nrows; ++i)
+    {
+        cols.clear();
+        for (int pa = A.ptr[i]; pa < A.ptr[i+1]; ++pa) {
+            const int k = A.col[pa];
+            const Real a = A.val[pa];
+            for (int pb = B.ptr[k]; pb < B.ptr[k+1]; ++pb) {
+                const int j = B.col[pb];
+                if (marker[j] != i) {
+                    marker[j] = i;
+                    acc[j] = 0.0;
+                    cols.push_back(j);
+                }
+                acc[j] += a * B.val[pb];
+            }
+        }
+        std::sort(cols.begin(), cols.end());
+        for (int j : cols) {
+            C.col.push_back(j);
+            C.val.push_back(acc[j]);
+        }
+        C.ptr[i+1] = C.col.size();
+    }
+    return C;
+}
+
+Real diagonal (const Matrix& A, int i)
+{
+    for (int p = A.ptr[i]; p < A.ptr[i+1]; ++p) {
+        if (A.col[p] == i) return A.val[p];
+    }
+    return 0.0;
+}
+
+//
+// Greedy aggregation on the graph of strong connections.  Returns the
+// number of aggregates.  Points without strong connections are left out
+// (agg = -1); the smoother takes care of them.
+//
+int aggregate (const Matrix& A, const Vector<char>& strong, Vector<int>& agg)
+{
+    const int n = A.nrows;
+    agg.assign(n, -1);
+    int nagg = 0;
+
+    // Points whose strong neighbors are all free start an aggregate.
+    for (int i = 0; i < n; ++i)
+    {
+        if (agg[i] >= 0) continue;
+        bool has_strong = false;
+        bool free = true;
+        for (int p = A.ptr[i]; p < A.ptr[i+1]; ++p) {
+            if (strong[p]) {
+                has_strong = true;
+                free = free && agg[A.col[p]] < 0;
+            }
+        }
+        if (has_strong && free) {
+            agg[i] = nagg;
+            for (int p = A.ptr[i]; p < A.ptr[i+1]; ++p) {
+                if (strong[p]) agg[A.col[p]] = nagg;
+            }
+            ++nagg;
+        }
+    }
+
+    // The rest join the aggregate they are most strongly connected to.
+    const Vector<int> agg1 = agg;
+    for (int i = 0; i < n; ++i)
+    {
+        if (agg[i] >= 0) continue;
+        Real amax = 0.0;
+        for (int p = A.ptr[i]; p < A.ptr[i+1]; ++p) {
+            if (strong[p] && agg1[A.col[p]] >= 0 && std::abs(A.val[p]) > amax) {
+                amax = std::abs(A.val[p]);
+                agg[i] = agg1[A.col[p]];
+            }
+        }
+    }
+
+    // Anything left over forms aggregates with its free neighbors.
+    for (int i = 0; i < n; ++i)
+    {
+        if (agg[i] >= 0) continue;
+        bool has_strong = false;
+        for (int p = A.ptr[i]; p < A.ptr[i+1]; ++p) {
+            has_strong = has_strong || strong[p];
+        }
+        if (has_strong) {
+            agg[i] = nagg;
+            for (int p = A.ptr[i]; p < A.ptr[i+1]; ++p) {
+                if (strong[p] && agg[A.col[p]] < 0) agg[A.col[p]] = nagg;
+            }
+            ++nagg;
+        }
+    }
+
+    return nagg;
+}
+
+//
+// Smoothed prolongation, P = (I - omega D^-1 A_F) P_0, where P_0 is
+// piecewise constant on the aggregates and A_F is A with the weak
+// connections lumped into the diagonal.
+//
+Matrix smoothedProlongation (const Matrix& A, const Vector<char>& strong,
+                             const Vector<int>& agg, int nagg)
+{
+    const int n = A.nrows;
+
+    Matrix AF;
+    AF.nrows = AF.ncols = n;
+    AF.ptr.assign(n+1, 0);
+    Vector<Real> dF(n);
+    Real rho = 0.0;
+    for (int i = 0; i < n; ++i)
+    {
+        Real d = 0.0;
+        for (int p = A.ptr[i]; p < A.ptr[i+1]; ++p) {
+            if (A.col[p] == i || !strong[p]) d += A.val[p];
+        }
+        dF[i] = d;
+        Real rowsum = std::abs(d);
+        for (int p = A.ptr[i]; p < A.ptr[i+1]; ++p) {
+            const int j = A.col[p];
+            if (j == i) {
+                AF.col.push_back(i);
+                AF.val.push_back(d);
+            } else if (strong[p]) {
+                AF.col.push_back(j);
+                AF.val.push_back(A.val[p]);
+                rowsum += std::abs(A.val[p]);
+            }
+        }
+        AF.ptr[i+1] = AF.col.size();
+        if (d != 0.0) rho = std::max(rho, rowsum/std::abs(d));
+    }
+    // Gershgorin bound on the spectral radius of D^-1 A_F
+    const Real omega = (rho > 0.0) ? 4.0/(3.0*rho) : 0.0;
+
+    Matrix P0;
+    P0.nrows = n;
+    P0.ncols = nagg;
+    P0.ptr.assign(n+1, 0);
+    for (int i = 0; i < n; ++i) {
+        if (agg[i] >= 0) {
+            P0.col.push_back(agg[i]);
+            P0.val.push_back(1.0);
+        }
+        P0.ptr[i+1] = P0.col.size();
+    }
+
+    Matrix P = multiply(AF, P0);
+    for (int i = 0; i < n; ++i)
+    {
+        const Real s = (dF[i] != 0.0) ? -omega/dF[i] : 0.0;
+        for (int p = P.ptr[i]; p < P.ptr[i+1]; ++p) {
+            P.val[p] *= s;
+            if (P.col[p] == agg[i]) P.val[p] += 1.0;
+        }
+    }
+    return P;
+}
+
+}
+
+MLAMGSolver::MLAMGSolver (MLLinOp& lp, const MultiFab& b)
+{
+    BL_PROFILE("MLAMGSolver::MLAMGSolver()");
+
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(lp.getNComp() == 1, "MLAMGSolver doesn't work with ncomp > 1");
+
+    ParmParse pp("mg");
+    pp.query("amg_nu", nu);
+    pp.query("amg_max_coarse_size", max_coarse_size);
+    pp.query("amg_max_levels", max_levels);
+    pp.query("amg_theta", theta);
+
+    assemble(lp, b);
+}
+
+MLAMGSolver::~MLAMGSolver () {}
+
+//
+// Each point is given a color such that points of the same color are
+// further apart than the reach of the stencil.  Applying the operator to
+// the indicator of one color then gives, at every point, the coefficient
+// of the only neighbor of that color.
+//
+void
+MLAMGSolver::assemble (MLLinOp& lp, const MultiFab& b)
+{
+    BL_PROFILE("MLAMGSolver::assemble()");
+
+    const int amrlev = 0;
+    const int mglev = lp.NMGLevels(amrlev) - 1;
+    const Geometry& geom = lp.Geom(amrlev, mglev);
+    const Box& domain = geom.Domain();
+    const BoxArray& ba = b.boxArray();
+    const DistributionMapping& dm = b.DistributionMap();
+
+    m_cell_centered = ba.ixType().cellCentered();
+    m_period = geom.periodicity();
+
+    // Higher order extrapolation at Dirichlet boundaries reaches further in.
+    const int reach = m_cell_centered ? std::max(1, lp.getMaxOrder()-2) : 1;
+
+    IntVect ncolor;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        int p = 2*reach+1;
+        if (geom.isPeriodic(idim)) {
+            // The colors have to match across the periodic boundary.
+            const int n = domain.length(idim);
+            if (p > n) {
+                p = n;
+            } else {
+                while (n % p != 0) ++p;
+            }
+        }
+        ncolor[idim] = p;
+    }
+    const int ncolors = AMREX_D_TERM(ncolor[0], *ncolor[1], *ncolor[2]);
+    const IntVect dlo = domain.smallEnd();
+    auto color = [&] (const IntVect& iv) -> int
+    {
+        int c = 0;
+        for (int idim = AMREX_SPACEDIM-1; idim >= 0; --idim) {
+            int m = (iv[idim] - dlo[idim]) % ncolor[idim];
+            if (m < 0) m += ncolor[idim];
+            c = c*ncolor[idim] + m;
+        }
+        return c;
+    };
+
+    m_owner = amrex::OwnerMask(b, m_period);
+
+    int nlocal = 0;
+    for (MFIter mfi(b); mfi.isValid(); ++mfi) {
+        const auto& msk = m_owner->const_array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+        {
+            if (msk(i,j,k)) ++nlocal;
+        });
+    }
+
+    const int nprocs = ParallelContext::NProcsSub();
+    m_counts.assign(nprocs, 0);
+#ifdef BL_USE_MPI
+    MPI_Allgather(&nlocal, 1, MPI_INT, m_counts.data(), 1, MPI_INT,
+                  ParallelContext::CommunicatorSub());
+#else
+    m_counts[0] = nlocal;
+#endif
+    m_offsets.assign(nprocs+1, 0);
+    for (int i = 0; i < nprocs; ++i) {
+        m_offsets[i+1] = m_offsets[i] + m_counts[i];
+    }
+    const int ntotal = m_offsets[nprocs];
+
+    m_gid.define(ba, dm, 1, reach);
+    m_gid.setVal(-1.0);
+    {
+        int id = m_offsets[ParallelContext::MyProcSub()];
+        for (MFIter mfi(m_gid); mfi.isValid(); ++mfi) {
+            const auto& msk = m_owner->const_array(mfi);
+            const auto& gid = m_gid.array(mfi);
+            amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+            {
+                if (msk(i,j,k)) gid(i,j,k) = id++;
+            });
+        }
+    }
+    if (!m_cell_centered) {
+        m_gid.OverrideSync(*m_owner, m_period);
+    }
+    m_gid.FillBoundary(m_period);
+
+    const auto& factory = *lp.Factory(amrlev, mglev);
+    MultiFab in(ba, dm, 1, 1, MFInfo(), factory);
+    MultiFab out(ba, dm, 1, 0, MFInfo(), factory);
+
+    Vector<Vector<std::pair<int,Real> > > rows(nlocal);
+
+    for (int c = 0; c < ncolors; ++c)
+    {
+        in.setVal(0.0);
+        for (MFIter mfi(in); mfi.isValid(); ++mfi) {
+            const auto& a = in.array(mfi);
+            amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+            {
+                if (color(IntVect(AMREX_D_DECL(i,j,k))) == c) a(i,j,k) = 1.0;
+            });
+        }
+
+        lp.apply(amrlev, mglev, out, in, MLLinOp::BCMode::Homogeneous,
+                 MLLinOp::StateMode::Correction);
+
+        int irow = 0;
+        for (MFIter mfi(out); mfi.isValid(); ++mfi) {
+            const auto& msk = m_owner->const_array(mfi);
+            const auto& gid = m_gid.const_array(mfi);
+            const auto& y = out.const_array(mfi);
+            amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+            {
+                if (!msk(i,j,k)) return;
+                auto& row = rows[irow++];
+                const Real v = y(i,j,k);
+                if (v == 0.0) return;
+                const IntVect iv(AMREX_D_DECL(i,j,k));
+                const Box nbhd = amrex::grow(Box(iv,iv), reach);
+                for (BoxIterator bi(nbhd); bi.ok(); ++bi) {
+                    const IntVect& e = bi();
+                    const int col = static_cast<int>(gid(e));
+                    if (col >= 0 && color(e) == c) {
+                        row.push_back(std::make_pair(col,v));
+                        break;
+                    }
+                }
+            });
+        }
+    }
+
+    // local rows, sorted by column
+    Vector<int> lnnz(nlocal);
+    Vector<int> lcol;
+    Vector<Real> lval;
+    for (int i = 0; i < nlocal; ++i)
+    {
+        auto& row = rows[i];
+        if (row.empty()) {
+            // not an unknown, e.g., a covered cell or a Dirichlet node
+            row.push_back(std::make_pair(m_offsets[ParallelContext::MyProcSub()]+i, 1.0));
+        }
+        std::sort(row.begin(), row.end());
+        lnnz[i] = row.size();
+        for (const auto& e : row) {
+            lcol.push_back(e.first);
+            lval.push_back(e.second);
+        }
+    }
+
+    // Every process gets the whole matrix.
+    m_levels.resize(1);
+    Matrix& A = m_levels[0].A;
+    A.nrows = A.ncols = ntotal;
+    Vector<int> rownnz(ntotal);
+#ifdef BL_USE_MPI
+    MPI_Comm comm = ParallelContext::CommunicatorSub();
+    MPI_Allgatherv(lnnz.data(), nlocal, MPI_INT, rownnz.data(), m_counts.data(),
+                   m_offsets.data(), MPI_INT, comm);
+    int mynnz = lcol.size();
+    Vector<int> nnzcounts(nprocs);
+    MPI_Allgather(&mynnz, 1, MPI_INT, nnzcounts.data(), 1, MPI_INT, comm);
+    Vector<int> nnzoffsets(nprocs+1, 0);
+    for (int i = 0; i < nprocs; ++i) {
+        nnzoffsets[i+1] = nnzoffsets[i] + nnzcounts[i];
+    }
+    A.col.resize(nnzoffsets[nprocs]);
+    A.val.resize(nnzoffsets[nprocs]);
+    MPI_Allgatherv(lcol.data(), mynnz, MPI_INT, A.col.data(), nnzcounts.data(),
+                   nnzoffsets.data(), MPI_INT, comm);
+    const MPI_Datatype typ = ParallelDescriptor::Mpi_typemap<Real>::type();
+    MPI_Allgatherv(lval.data(), mynnz, typ, A.val.data(), nnzcounts.data(),
+                   nnzoffsets.data(), typ, comm);
+#else
+    rownnz = lnnz;
+    A.col = std::move(lcol);
+    A.val = std::move(lval);
+#endif
+    A.ptr.assign(ntotal+1, 0);
+    for (int i = 0; i < ntotal; ++i) {
+        A.ptr[i+1] = A.ptr[i] + rownnz[i];
+    }
+
+    const Matrix AT = transpose(A);
+    m_symmetric = (AT.col == A.col);
+    for (int p = 0, nnz = A.ptr[ntotal]; p < nnz && m_symmetric; ++p) {
+        m_symmetric = std::abs(A.val[p]-AT.val[p])
+            <= 1.e-12 * std::max(std::abs(A.val[p]), std::abs(AT.val[p]));
+    }
+}
+
+void
+MLAMGSolver::setup ()
+{
+    BL_PROFILE("MLAMGSolver::setup()");
+
+    for (int lev = 0; ; ++lev)
+    {
+        {
+            Level& L = m_levels[lev];
+            const Matrix& A = L.A;
+            const int n = A.nrows;
+            L.dinv.resize(n);
+            for (int i = 0; i < n; ++i) {
+                Real s = 0.0;
+                for (int p = A.ptr[i]; p < A.ptr[i+1]; ++p) {
+                    s += std::abs(A.val[p]);
+                }
+                L.dinv[i] = (s > 0.0) ? 1.0/s : 0.0;
+            }
+            L.x.resize(n);
+            L.b.resize(n);
+            L.r.resize(n);
+            if (n <= max_coarse_size || lev+1 >= max_levels) break;
+        }
+
+        const Matrix& A = m_levels[lev].A;
+        const int n = A.nrows;
+        Vector<char> strong(A.ptr[n], 0);
+        for (int i = 0; i < n; ++i) {
+            const Real aii = diagonal(A, i);
+            for (int p = A.ptr[i]; p < A.ptr[i+1]; ++p) {
+                const int j = A.col[p];
+                if (j != i) {
+                    const Real ajj = diagonal(A, j);
+                    strong[p] = std::abs(A.val[p]) > theta * std::sqrt(std::abs(aii*ajj));
+                }
+            }
+        }
+
+        Vector<int> agg;
+        const int nagg = aggregate(A, strong, agg);
+        if (nagg == 0 || nagg > 0.9*n) break;  // coarsening has stalled
+
+        Matrix P = smoothedProlongation(A, strong, agg, nagg);
+        Matrix R = transpose(P);
+        Matrix Ac = multiply(R, multiply(A, P));
+
+        m_levels[lev].P = std::move(P);
+        m_levels[lev].R = std::move(R);
+        m_levels.push_back(Level());
+        m_levels.back().A = std::move(Ac);
+    }
+
+    // Direct solve on the coarsest level unless coarsening stalled early.
+    const Matrix& A = m_levels.back().A;
+    const int n = A.nrows;
+    if (n <= 4*max_coarse_size)
+    {
+        m_lu.assign(n*n, 0.0);
+        m_piv.resize(n);
+        m_dropped.assign(n, 0);
+        Real scale = 0.0;
+        for (int i = 0; i < n; ++i) {
+            for (int p = A.ptr[i]; p < A.ptr[i+1]; ++p) {
+                m_lu[i*n+A.col[p]] = A.val[p];
+            }
+            scale = std::max(scale, std::abs(diagonal(A,i)));
+        }
+        const Real tiny = 1.e-12 * scale;
+        for (int k = 0; k < n; ++k)
+        {
+            int piv = k;
+            for (int i = k+1; i < n; ++i) {
+                if (std::abs(m_lu[i*n+k]) > std::abs(m_lu[piv*n+k])) piv = i;
+            }
+            m_piv[k] = piv;
+            if (piv != k) {
+                std::swap_ranges(&m_lu[k*n], &m_lu[k*n]+n, &m_lu[piv*n]);
+            }
+            if (std::abs(m_lu[k*n+k]) <= tiny) {
+                // Singular, e.g., pure Neumann.  This unknown is set to zero.
+                m_dropped[k] = 1;
+                continue;
+            }
+            for (int i = k+1; i < n; ++i) {
+                const Real l = m_lu[i*n+k] / m_lu[k*n+k];
+                m_lu[i*n+k] = l;
+                for (int j = k+1; j < n; ++j) {
+                    m_lu[i*n+j] -= l * m_lu[k*n+j];
+                }
+            }
+        }
+    }
+
+    if (verbose > 0)
+    {
+        long nnz0 = m_levels[0].A.ptr.back();
+        long nnz = 0;
+        amrex::Print() << "MLAMGSolver: " << m_levels.size() << " levels,"
+                       << (m_symmetric ? " symmetric" : " nonsymmetric") << "\n";
+        for (int lev = 0; lev < m_levels.size(); ++lev) {
+            const Matrix& Al = m_levels[lev].A;
+            nnz += Al.ptr.back();
+            amrex::Print() << "    level " << lev << ": " << Al.nrows << " rows, "
+                           << Al.ptr.back() << " nonzeros\n";
+        }
+        amrex::Print() << "    operator complexity " << Real(nnz)/Real(nnz0) << "\n";
+    }
+}
+
+void
+MLAMGSolver::vcycle (int lev) const
+{
+    const Level& L = m_levels[lev];
+    const int n = L.A.nrows;
+    const bool coarsest = (lev+1 == static_cast<int>(m_levels.size()));
+
+    if (coarsest && !m_lu.empty())
+    {
+        Vector<Real>& x = L.x;
+        x = L.b;
+        for (int k = 0; k < n; ++k) {
+            if (m_piv[k] != k) std::swap(x[k], x[m_piv[k]]);
+        }
+        for (int i = 0; i < n; ++i) {
+            for (int k = 0; k < i; ++k) {
+                if (!m_dropped[k]) x[i] -= m_lu[i*n+k] * x[k];
+            }
+        }
+        for (int i = n-1; i >= 0; --i) {
+            if (m_dropped[i]) {
+                x[i] = 0.0;
+            } else {
+                Real s = x[i];
+                for (int j = i+1; j < n; ++j) {
+                    s -= m_lu[i*n+j] * x[j];
+                }
+                x[i] = s / m_lu[i*n+i];
+            }
+        }
+        return;
+    }
+
+    // l1-Jacobi, which is symmetric and convergent without damping.
+    auto smooth = [&] (int nsweeps)
+    {
+        for (int s = 0; s < nsweeps; ++s) {
+            residual(L.A, L.x, L.b, L.r);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for (int i = 0; i < n; ++i) {
+                L.x[i] += L.dinv[i] * L.r[i];
+            }
+        }
+    };
+
+    std::fill(L.x.begin(), L.x.end(), 0.0);
+
+    if (coarsest) {
+        smooth(10*nu);
+        return;
+    }
+
+    smooth(nu);
+
+    const Level& C = m_levels[lev+1];
+    residual(L.A, L.x, L.b, L.r);
+    spmv(L.R, L.r, C.b);
+    vcycle(lev+1);
+    spmv(L.P, C.x, L.r);
+    axpby(1.0, L.r, 1.0, L.x);
+
+    smooth(nu);
+}
+
+void
+MLAMGSolver::precond (Vector<Real>& z, const Vector<Real>& r) const
+{
+    m_levels[0].b = r;
+    vcycle(0);
+    z = m_levels[0].x;
+}
+
+int
+MLAMGSolver::pcg (Vector<Real>& x, const Vector<Real>& b, Real tol) const
+{
+    const Matrix& A = m_levels[0].A;
+    const int n = A.nrows;
+    Vector<Real> r(n), z(n), p(n), q(n);
+
+    residual(A, x, b, r);
+    precond(z, r);
+    p = z;
+    Real rz = dot(r, z);
+
+    int nit = 0;
+    Real rnorm = norminf(r);
+    int ret = 1;
+    for (; nit < maxiter; ++nit)
+    {
+        if (rnorm <= tol) { ret = 0; break; }
+        spmv(A, p, q);
+        const Real pq = dot(p, q);
+        if (pq == 0.0) break;
+        const Real alpha = rz / pq;
+        axpby(alpha, p, 1.0, x);
+        axpby(-alpha, q, 1.0, r);
+        rnorm = norminf(r);
+        if (rnorm <= tol) { ++nit; ret = 0; break; }
+        precond(z, r);
+        const Real rz_new = dot(r, z);
+        axpby(1.0, z, rz_new/rz, p);
+        rz = rz_new;
+    }
+
+    if (verbose > 0) {
+        amrex::Print() << "MLAMGSolver_CG: niter = " << nit << ", rnorm = " << rnorm
+                       << ", tol = " << tol << "\n";
+    }
+    return ret;
+}
+
+int
+MLAMGSolver::pbicgstab (Vector<Real>& x, const Vector<Real>& b, Real tol) const
+{
+    const Matrix& A = m_levels[0].A;
+    const int n = A.nrows;
+    Vector<Real> r(n), rh(n), p(n, 0.0), v(n, 0.0), ph(n), s(n), sh(n), t(n);
+
+    residual(A, x, b, r);
+    rh = r;
+    Real rho = 1.0, alpha = 1.0, omega = 1.0;
+
+    int nit = 0;
+    Real rnorm = norminf(r);
+    int ret = 1;
+    for (; nit < maxiter; ++nit)
+    {
+        if (rnorm <= tol) { ret = 0; break; }
+        const Real rho_new = dot(rh, r);
+        if (rho_new == 0.0) break;
+        const Real beta = (rho_new/rho)*(alpha/omega);
+        // p = r + beta*(p - omega*v)
+        axpby(-omega, v, 1.0, p);
+        axpby(1.0, r, beta, p);
+        precond(ph, p);
+        spmv(A, ph, v);
+        const Real rhv = dot(rh, v);
+        if (rhv == 0.0) break;
+        alpha = rho_new / rhv;
+        s = r;
+        axpby(-alpha, v, 1.0, s);
+        axpby(alpha, ph, 1.0, x);
+        rnorm = norminf(s);
+        if (rnorm <= tol) { ++nit; ret = 0; break; }
+        precond(sh, s);
+        spmv(A, sh, t);
+        const Real tt = dot(t, t);
+        if (tt == 0.0) break;
+        omega = dot(t, s) / tt;
+        axpby(omega, sh, 1.0, x);
+        r = s;
+        axpby(-omega, t, 1.0, r);
+        rnorm = norminf(r);
+        rho = rho_new;
+        if (omega == 0.0) break;
+    }
+
+    if (verbose > 0) {
+        amrex::Print() << "MLAMGSolver_BiCGStab: niter = " << nit << ", rnorm = " << rnorm
+                       << ", tol = " << tol << "\n";
+    }
+    return ret;
+}
+
+void
+MLAMGSolver::gatherVector (const MultiFab& mf, Vector<Real>& v) const
+{
+    const int nprocs = ParallelContext::NProcsSub();
+    const int myproc = ParallelContext::MyProcSub();
+    Vector<Real> local;
+    local.reserve(m_counts[myproc]);
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const auto& msk = m_owner->const_array(mfi);
+        const auto& a = mf.const_array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+        {
+            if (msk(i,j,k)) local.push_back(a(i,j,k));
+        });
+    }
+    v.resize(m_offsets[nprocs]);
+#ifdef BL_USE_MPI
+    const MPI_Datatype typ = ParallelDescriptor::Mpi_typemap<Real>::type();
+    MPI_Allgatherv(local.data(), local.size(), typ, v.data(), m_counts.data(),
+                   m_offsets.data(), typ, ParallelContext::CommunicatorSub());
+#else
+    v = std::move(local);
+#endif
+}
+
+int
+MLAMGSolver::solve (MultiFab& x, const MultiFab& b, Real eps_rel, Real eps_abs)
+{
+    BL_PROFILE("MLAMGSolver::solve()");
+
+    if (!m_setup_done) {
+        setup();
+        m_setup_done = true;
+    }
+
+    Vector<Real> bv;
+    gatherVector(b, bv);
+    Vector<Real> xv(bv.size(), 0.0);
+
+    const Real bnorm = norminf(bv);
+    const Real tol = std::max(eps_rel*bnorm, eps_abs);
+
+    int ret = 0;
+    if (bnorm > 0.0) {
+        ret = m_symmetric ? pcg(xv, bv, tol) : pbicgstab(xv, bv, tol);
+    }
+
+    for (MFIter mfi(x); mfi.isValid(); ++mfi) {
+        const auto& gid = m_gid.const_array(mfi);
+        const auto& a = x.array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+        {
+            const int id = static_cast<int>(gid(i,j,k));
+            if (id >= 0) a(i,j,k) = xv[id];
+        });
+    }
+    if (!m_cell_centered) {
+        // The processes solved the same problem, but may differ in rounding.
+        x.OverrideSync(*m_owner, m_period);
+    }
+
+    return ret;
+}
+
+}
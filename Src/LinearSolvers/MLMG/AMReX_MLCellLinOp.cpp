@@ -315,6 +315,66 @@ MLCellLinOp::interpolation (int amrlev, int fmglev, MultiFab& fine, const MultiF
     }    
 }
 
+void
+MLCellLinOp::restrictionF (int, int, FloatMultiFab& crse, FloatMultiFab& fine) const
+{
+    const int ncomp = getNComp();
+
+    // With agglomeration or consolidation the coarse grids are not simply
+    // the coarsened fine grids.
+    const BoxArray& cba = amrex::coarsen(fine.boxArray(), 2);
+    const bool aligned = cba == crse.boxArray() && fine.DistributionMap() == crse.DistributionMap();
+    FloatMultiFab ctmp;
+    if (!aligned) {
+        ctmp.define(cba, fine.DistributionMap(), ncomp, 0);
+    }
+    FloatMultiFab& cmf = aligned ? crse : ctmp;
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(cmf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        auto const cfab = cmf.array(mfi);
+        auto const ffab = fine.const_array(mfi);
+        AMREX_HOST_DEVICE_FOR_4D ( bx, ncomp, i, j, k, n,
+        {
+            float s = 0.f;
+            for (int kk = 0; kk < AMREX_D_PICK(1,1,2); ++kk) {
+            for (int jj = 0; jj < AMREX_D_PICK(1,2,2); ++jj) {
+            for (int ii = 0; ii < 2; ++ii) {
+                s += ffab(2*i+ii, 2*j+jj, 2*k+kk, n);
+            }}}
+            cfab(i,j,k,n) = s * (1.f/(AMREX_D_TERM(2.f,*2.f,*2.f)));
+        });
+    }
+
+    if (!aligned) {
+        crse.ParallelCopy(ctmp, 0, 0, ncomp);
+    }
+}
+
+void
+MLCellLinOp::interpolationF (int amrlev, int fmglev, FloatMultiFab& fine, const FloatMultiFab& crse) const
+{
+    const int ncomp = getNComp();
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(crse,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx    = mfi.tilebox();
+        auto const cfab = crse.const_array(mfi);
+        auto       ffab = fine.array(mfi);
+        AMREX_HOST_DEVICE_FOR_4D ( bx, ncomp, i, j, k, n,
+        {
+            mg_cc_interp(i,j,k,n,ffab,cfab);
+        });
+    }
+}
+
 void
 MLCellLinOp::averageDownSolutionRHS (int camrlev, MultiFab& crse_sol, MultiFab& crse_rhs,
                                      const MultiFab& fine_sol, const MultiFab& fine_rhs)
@@ -354,6 +414,19 @@ MLCellLinOp::smooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
     }
 }
 
+void
+MLCellLinOp::smoothF (int amrlev, int mglev, FloatMultiFab& sol, const FloatMultiFab& rhs,
+                      bool skip_fillboundary) const
+{
+    BL_PROFILE("MLCellLinOp::smoothF()");
+    for (int redblack = 0; redblack < 2; ++redblack)
+    {
+        applyBCF(amrlev, mglev, sol, skip_fillboundary);
+        FsmoothF(amrlev, mglev, sol, rhs, redblack);
+        skip_fillboundary = false;
+    }
+}
+
 void
 MLCellLinOp::updateSolBC (int amrlev, const MultiFab& crse_bcdata) const
 {
@@ -430,6 +503,30 @@ MLCellLinOp::correctionResidual (int amrlev, int mglev, MultiFab& resid, MultiFa
     MultiFab::Xpay(resid, -1.0, b, 0, 0, ncomp, 0);
 }
 
+void
+MLCellLinOp::correctionResidualF (int amrlev, int mglev, FloatMultiFab& resid, FloatMultiFab& x,
+                                  const FloatMultiFab& b) const
+{
+    BL_PROFILE("MLCellLinOp::correctionResidualF()");
+    const int ncomp = getNComp();
+    applyBCF(amrlev, mglev, x);
+    FapplyF(amrlev, mglev, resid, x);
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(resid,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        auto const rfab = resid.array(mfi);
+        auto const bfab = b.const_array(mfi);
+        AMREX_HOST_DEVICE_FOR_4D ( bx, ncomp, i, j, k, n,
+        {
+            rfab(i,j,k,n) = bfab(i,j,k,n) - rfab(i,j,k,n);
+        });
+    }
+}
+
 void
 MLCellLinOp::applyBC (int amrlev, int mglev, MultiFab& in, BCMode bc_mode, StateMode,
                       const MLMGBndry* bndry, bool skip_fillboundary) const
@@ -564,6 +661,99 @@ MLCellLinOp::applyBC (int amrlev, int mglev, MultiFab& in, BCMode bc_mode, State
     }
 }
 
+void
+MLCellLinOp::applyBCF (int amrlev, int mglev, FloatMultiFab& in, bool skip_fillboundary) const
+{
+    BL_PROFILE("MLCellLinOp::applyBCF()");
+    AMREX_ALWAYS_ASSERT(isCrossStencil() && !isTensorOp());
+
+    const int ncomp = getNComp();
+    if (!skip_fillboundary) {
+        in.FillBoundary(0, ncomp, m_geom[amrlev][mglev].periodicity(), true);
+    }
+
+    const int imaxorder = maxorder;
+    const Real dxi = m_geom[amrlev][mglev].InvCellSize(0);
+    const Real dyi = (AMREX_SPACEDIM >= 2) ? m_geom[amrlev][mglev].InvCellSize(1) : 1.0;
+    const Real dzi = (AMREX_SPACEDIM == 3) ? m_geom[amrlev][mglev].InvCellSize(2) : 1.0;
+
+    const auto& maskvals = m_maskvals[amrlev][mglev];
+    const auto& bcondloc = *m_bcondloc[amrlev][mglev];
+
+    // Homogeneous, so the boundary values are never read.
+    FArrayBox foofab(Box::TheUnitBox(),ncomp);
+    const auto& foo = foofab.const_array();
+
+    MFItInfo mfi_info;
+    if (Gpu::notInLaunchRegion()) mfi_info.SetDynamic(true);
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(in, mfi_info); mfi.isValid(); ++mfi)
+    {
+        const Box& vbx   = mfi.validbox();
+        const auto& iofab = in.array(mfi);
+
+        const auto & bdlv = bcondloc.bndryLocs(mfi);
+        const auto & bdcv = bcondloc.bndryConds(mfi);
+
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+        {
+            const Orientation olo(idim,Orientation::low);
+            const Orientation ohi(idim,Orientation::high);
+            const Box blo = amrex::adjCellLo(vbx, idim);
+            const Box bhi = amrex::adjCellHi(vbx, idim);
+            const int blen = vbx.length(idim);
+            const auto& mlo = maskvals[olo].array(mfi);
+            const auto& mhi = maskvals[ohi].array(mfi);
+            for (int icomp = 0; icomp < ncomp; ++icomp) {
+                const BoundCond bctlo = bdcv[icomp][olo];
+                const BoundCond bcthi = bdcv[icomp][ohi];
+                const Real bcllo = bdlv[icomp][olo];
+                const Real bclhi = bdlv[icomp][ohi];
+                if (idim == 0) {
+                    AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
+                    blo, tboxlo, {
+                    mllinop_apply_bc_x(0, tboxlo, blen, iofab, mlo,
+                                       bctlo, bcllo, foo,
+                                       imaxorder, dxi, 0, icomp);
+                    },
+                    bhi, tboxhi, {
+                    mllinop_apply_bc_x(1, tboxhi, blen, iofab, mhi,
+                                       bcthi, bclhi, foo,
+                                       imaxorder, dxi, 0, icomp);
+                    });
+                } else if (idim == 1) {
+                    AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
+                    blo, tboxlo, {
+                    mllinop_apply_bc_y(0, tboxlo, blen, iofab, mlo,
+                                       bctlo, bcllo, foo,
+                                       imaxorder, dyi, 0, icomp);
+                    },
+                    bhi, tboxhi, {
+                    mllinop_apply_bc_y(1, tboxhi, blen, iofab, mhi,
+                                       bcthi, bclhi, foo,
+                                       imaxorder, dyi, 0, icomp);
+                    });
+                } else {
+                    AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
+                    blo, tboxlo, {
+                    mllinop_apply_bc_z(0, tboxlo, blen, iofab, mlo,
+                                       bctlo, bcllo, foo,
+                                       imaxorder, dzi, 0, icomp);
+                    },
+                    bhi, tboxhi, {
+                    mllinop_apply_bc_z(1, tboxhi, blen, iofab, mhi,
+                                       bcthi, bclhi, foo,
+                                       imaxorder, dzi, 0, icomp);
+                    });
+                }
+            }
+        }
+    }
+}
+
 void
 MLCellLinOp::reflux (int crse_amrlev,
                      MultiFab& res, const MultiFab& crse_sol, const MultiFab&,
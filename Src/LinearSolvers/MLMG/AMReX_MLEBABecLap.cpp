@@ -403,12 +403,10 @@ MLEBABecLap::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& in) c
     auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get());
     const FabArray<EBCellFlagFab>* flags = (factory) ? &(factory->getMultiEBCellFlagFab()) : nullptr;
     const MultiFab* vfrac = (factory) ? &(factory->getVolFrac()) : nullptr;
-    auto area = (factory) ? factory->getAreaFrac()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-    auto fcent = (factory) ? factory->getFaceCent()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-    const MultiCutFab* barea = (factory) ? &(factory->getBndryArea()) : nullptr;
-    const MultiCutFab* bcent = (factory) ? &(factory->getBndryCent()) : nullptr;
+    auto area = (factory) ? factory->getAreaFracData() : Array<EBCutData,AMREX_SPACEDIM>{};
+    auto fcent = (factory) ? factory->getFaceCentData() : Array<EBCutData,AMREX_SPACEDIM>{};
+    const EBCutData barea = (factory) ? factory->getBndryAreaData() : EBCutData();
+    const EBCutData bcent = (factory) ? factory->getBndryCentData() : EBCutData();
 
     const int is_eb_dirichlet =  isEBDirichlet();
 
@@ -447,6 +445,18 @@ MLEBABecLap::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& in) c
             FArrayBox const& bebfab = (is_eb_dirichlet) ? (*m_eb_b_coeffs[amrlev][mglev])[mfi] : foo;
             FArrayBox const& phiebfab = (is_eb_dirichlet && m_is_eb_inhomog) ? (*m_eb_phi[amrlev])[mfi] : foo;
 
+            // The kernels read only the cut cell data of the box and its faces.
+            Array<FArrayBox,AMREX_SPACEDIM> atmp, ctmp;
+            AMREX_D_TERM(const FArrayBox& apxfab = area[0].fab(mfi,bx,atmp[0]);,
+                         const FArrayBox& apyfab = area[1].fab(mfi,bx,atmp[1]);,
+                         const FArrayBox& apzfab = area[2].fab(mfi,bx,atmp[2]););
+            AMREX_D_TERM(const FArrayBox& fcxfab = fcent[0].fab(mfi,bx,ctmp[0]);,
+                         const FArrayBox& fcyfab = fcent[1].fab(mfi,bx,ctmp[1]);,
+                         const FArrayBox& fczfab = fcent[2].fab(mfi,bx,ctmp[2]););
+            FArrayBox batmp, bctmp;
+            const FArrayBox& bafab = barea.fab(mfi,bx,batmp);
+            const FArrayBox& bcfab = bcent.fab(mfi,bx,bctmp);
+
             amrex_mlebabeclap_adotx(BL_TO_FORTRAN_BOX(bx),
                                     BL_TO_FORTRAN_ANYD(yfab),
                                     BL_TO_FORTRAN_ANYD(xfab),
@@ -457,14 +467,14 @@ MLEBABecLap::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& in) c
                                     BL_TO_FORTRAN_ANYD(ccmask[mfi]),
                                     BL_TO_FORTRAN_ANYD((*flags)[mfi]),
                                     BL_TO_FORTRAN_ANYD((*vfrac)[mfi]),
-                                    AMREX_D_DECL(BL_TO_FORTRAN_ANYD((*area[0])[mfi]),
-                                                 BL_TO_FORTRAN_ANYD((*area[1])[mfi]),
-                                                 BL_TO_FORTRAN_ANYD((*area[2])[mfi])),
-                                    AMREX_D_DECL(BL_TO_FORTRAN_ANYD((*fcent[0])[mfi]),
-                                                 BL_TO_FORTRAN_ANYD((*fcent[1])[mfi]),
-                                                 BL_TO_FORTRAN_ANYD((*fcent[2])[mfi])),
-                                    BL_TO_FORTRAN_ANYD((*barea)[mfi]),
-                                    BL_TO_FORTRAN_ANYD((*bcent)[mfi]),
+                                    AMREX_D_DECL(BL_TO_FORTRAN_ANYD(apxfab),
+                                                 BL_TO_FORTRAN_ANYD(apyfab),
+                                                 BL_TO_FORTRAN_ANYD(apzfab)),
+                                    AMREX_D_DECL(BL_TO_FORTRAN_ANYD(fcxfab),
+                                                 BL_TO_FORTRAN_ANYD(fcyfab),
+                                                 BL_TO_FORTRAN_ANYD(fczfab)),
+                                    BL_TO_FORTRAN_ANYD(bafab),
+                                    BL_TO_FORTRAN_ANYD(bcfab),
                                     BL_TO_FORTRAN_ANYD(bebfab), 
                                     is_eb_dirichlet,
                                     BL_TO_FORTRAN_ANYD(phiebfab), m_is_eb_inhomog,
@@ -523,12 +533,10 @@ MLEBABecLap::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
     auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get());
     const FabArray<EBCellFlagFab>* flags = (factory) ? &(factory->getMultiEBCellFlagFab()) : nullptr;
     const MultiFab* vfrac = (factory) ? &(factory->getVolFrac()) : nullptr;
-    auto area = (factory) ? factory->getAreaFrac()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-    auto fcent = (factory) ? factory->getFaceCent()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-    const MultiCutFab* barea = (factory) ? &(factory->getBndryArea()) : nullptr;
-    const MultiCutFab* bcent = (factory) ? &(factory->getBndryCent()) : nullptr;
+    auto area = (factory) ? factory->getAreaFracData() : Array<EBCutData,AMREX_SPACEDIM>{};
+    auto fcent = (factory) ? factory->getFaceCentData() : Array<EBCutData,AMREX_SPACEDIM>{};
+    const EBCutData barea = (factory) ? factory->getBndryAreaData() : EBCutData();
+    const EBCutData bcent = (factory) ? factory->getBndryCentData() : EBCutData();
 
     const int is_eb_dirichlet =  isEBDirichlet();
 
@@ -641,6 +649,18 @@ MLEBABecLap::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
 
             FArrayBox const& bebfab_ = (is_eb_dirichlet) ? (*m_eb_b_coeffs[amrlev][mglev])[mfi] : foo;
 
+            // The kernels read only the cut cell data of the box and its faces.
+            Array<FArrayBox,AMREX_SPACEDIM> atmp, ctmp;
+            AMREX_D_TERM(const FArrayBox& apxfab = area[0].fab(mfi,tbx,atmp[0]);,
+                         const FArrayBox& apyfab = area[1].fab(mfi,tbx,atmp[1]);,
+                         const FArrayBox& apzfab = area[2].fab(mfi,tbx,atmp[2]););
+            AMREX_D_TERM(const FArrayBox& fcxfab = fcent[0].fab(mfi,tbx,ctmp[0]);,
+                         const FArrayBox& fcyfab = fcent[1].fab(mfi,tbx,ctmp[1]);,
+                         const FArrayBox& fczfab = fcent[2].fab(mfi,tbx,ctmp[2]););
+            FArrayBox batmp, bctmp;
+            const FArrayBox& bafab = barea.fab(mfi,tbx,batmp);
+            const FArrayBox& bcfab = bcent.fab(mfi,tbx,bctmp);
+
             amrex_mlebabeclap_gsrb(BL_TO_FORTRAN_BOX(tbx),
                                    BL_TO_FORTRAN_ANYD(solnfab_),
                                    BL_TO_FORTRAN_ANYD(rhsfab_),
@@ -663,14 +683,14 @@ MLEBABecLap::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
                                                 BL_TO_FORTRAN_ANYD(f5fab_)),
                                    BL_TO_FORTRAN_ANYD((*flags)[mfi]),
                                    BL_TO_FORTRAN_ANYD((*vfrac)[mfi]),
-                                   AMREX_D_DECL(BL_TO_FORTRAN_ANYD((*area[0])[mfi]),
-                                                BL_TO_FORTRAN_ANYD((*area[1])[mfi]),
-                                                BL_TO_FORTRAN_ANYD((*area[2])[mfi])),
-                                   AMREX_D_DECL(BL_TO_FORTRAN_ANYD((*fcent[0])[mfi]),
-                                                BL_TO_FORTRAN_ANYD((*fcent[1])[mfi]),
-                                                BL_TO_FORTRAN_ANYD((*fcent[2])[mfi])),
-                                   BL_TO_FORTRAN_ANYD((*barea)[mfi]),
-                                   BL_TO_FORTRAN_ANYD((*bcent)[mfi]),
+                                   AMREX_D_DECL(BL_TO_FORTRAN_ANYD(apxfab),
+                                                BL_TO_FORTRAN_ANYD(apyfab),
+                                                BL_TO_FORTRAN_ANYD(apzfab)),
+                                   AMREX_D_DECL(BL_TO_FORTRAN_ANYD(fcxfab),
+                                                BL_TO_FORTRAN_ANYD(fcyfab),
+                                                BL_TO_FORTRAN_ANYD(fczfab)),
+                                   BL_TO_FORTRAN_ANYD(bafab),
+                                   BL_TO_FORTRAN_ANYD(bcfab),
                                    BL_TO_FORTRAN_ANYD(bebfab_), 
                                    is_eb_dirichlet,
                                    dxinv, m_a_scalar, m_b_scalar, redblack, nc);
@@ -709,10 +729,11 @@ MLEBABecLap::FFlux (int amrlev, const MFIter& mfi, const Array<FArrayBox*,AMREX_
                                Array<FArrayBox const*,AMREX_SPACEDIM>{AMREX_D_DECL(&bx,&by,&bz)},
                                flux, sol, face_only, ncomp);
         if (fabtyp != FabType::regular && !face_only) {
-            const auto& area = factory->getAreaFrac();
-            AMREX_D_TERM(Array4<Real const> const& ax = area[0]->const_array(mfi);,
-                         Array4<Real const> const& ay = area[1]->const_array(mfi);,
-                         Array4<Real const> const& az = area[2]->const_array(mfi););
+            const auto& area = factory->getAreaFracData();
+            Array<FArrayBox,AMREX_SPACEDIM> atmp;
+            AMREX_D_TERM(Array4<Real const> const& ax = area[0].fab(mfi,box,atmp[0]).const_array();,
+                         Array4<Real const> const& ay = area[1].fab(mfi,box,atmp[1]).const_array();,
+                         Array4<Real const> const& az = area[2].fab(mfi,box,atmp[2]).const_array(););
             AMREX_D_TERM(const Box& xbx = amrex::surroundingNodes(box,0);,
                          const Box& ybx = amrex::surroundingNodes(box,1);,
                          const Box& zbx = amrex::surroundingNodes(box,2););
@@ -761,19 +782,28 @@ MLEBABecLap::FFlux (int amrlev, const MFIter& mfi, const Array<FArrayBox*,AMREX_
                 );
         }
     } else {
-        const auto& area = factory->getAreaFrac();
-        const auto& fcent = factory->getFaceCent();
+        const auto& area = factory->getAreaFracData();
+        const auto& fcent = factory->getFaceCentData();
+
+        // The kernels read only the cut cell data of the box and its faces.
+        Array<FArrayBox,AMREX_SPACEDIM> atmp, ctmp;
+        AMREX_D_TERM(const FArrayBox& apxfab = area[0].fab(mfi,box,atmp[0]);,
+                     const FArrayBox& apyfab = area[1].fab(mfi,box,atmp[1]);,
+                     const FArrayBox& apzfab = area[2].fab(mfi,box,atmp[2]););
+        AMREX_D_TERM(const FArrayBox& fcxfab = fcent[0].fab(mfi,box,ctmp[0]);,
+                     const FArrayBox& fcyfab = fcent[1].fab(mfi,box,ctmp[1]);,
+                     const FArrayBox& fczfab = fcent[2].fab(mfi,box,ctmp[2]););
 
         amrex_mlebabeclap_flux(BL_TO_FORTRAN_BOX(box), 
                                AMREX_D_DECL(BL_TO_FORTRAN_ANYD(*flux[0]),
                                             BL_TO_FORTRAN_ANYD(*flux[1]), 
                                             BL_TO_FORTRAN_ANYD(*flux[2])),
-                               AMREX_D_DECL(BL_TO_FORTRAN_ANYD((*area[0])[mfi]), 
-                                            BL_TO_FORTRAN_ANYD((*area[1])[mfi]),
-                                            BL_TO_FORTRAN_ANYD((*area[2])[mfi])),
-                               AMREX_D_DECL(BL_TO_FORTRAN_ANYD((*fcent[0])[mfi]),
-                                            BL_TO_FORTRAN_ANYD((*fcent[1])[mfi]),
-                                            BL_TO_FORTRAN_ANYD((*fcent[2])[mfi])),
+                               AMREX_D_DECL(BL_TO_FORTRAN_ANYD(apxfab), 
+                                            BL_TO_FORTRAN_ANYD(apyfab),
+                                            BL_TO_FORTRAN_ANYD(apzfab)),
+                               AMREX_D_DECL(BL_TO_FORTRAN_ANYD(fcxfab),
+                                            BL_TO_FORTRAN_ANYD(fcyfab),
+                                            BL_TO_FORTRAN_ANYD(fczfab)),
                                BL_TO_FORTRAN_ANYD(sol),
                                AMREX_D_DECL(BL_TO_FORTRAN_ANYD(bx),
                                             BL_TO_FORTRAN_ANYD(by),
@@ -806,10 +836,8 @@ MLEBABecLap::compGrad (int amrlev, const Array<MultiFab*,AMREX_SPACEDIM>& grad,
 
     auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get()); 
     const FabArray<EBCellFlagFab>* flags = (factory) ? &(factory->getMultiEBCellFlagFab()) : nullptr; 
-    auto area = (factory) ? factory->getAreaFrac() : 
-        Array<const MultiCutFab*, AMREX_SPACEDIM>{AMREX_D_DECL(nullptr, nullptr, nullptr)}; 
-    auto fcent = (factory) ? factory->getFaceCent():
-        Array<const MultiCutFab*, AMREX_SPACEDIM>{AMREX_D_DECL(nullptr, nullptr, nullptr)}; 
+    auto area = (factory) ? factory->getAreaFracData() : Array<EBCutData,AMREX_SPACEDIM>{};
+    auto fcent = (factory) ? factory->getFaceCentData() : Array<EBCutData,AMREX_SPACEDIM>{};
 
 #ifdef _OPENMP
 #pragma omp parallel
@@ -847,9 +875,10 @@ MLEBABecLap::compGrad (int amrlev, const Array<MultiFab*,AMREX_SPACEDIM>& grad,
             });
 #endif
             if (fabtyp != FabType::regular) {
-                AMREX_D_TERM(Array4<Real const> const& ax = area[0]->const_array(mfi);,
-                             Array4<Real const> const& ay = area[1]->const_array(mfi);,
-                             Array4<Real const> const& az = area[2]->const_array(mfi););
+                Array<FArrayBox,AMREX_SPACEDIM> atmp;
+                AMREX_D_TERM(Array4<Real const> const& ax = area[0].fab(mfi,box,atmp[0]).const_array();,
+                             Array4<Real const> const& ay = area[1].fab(mfi,box,atmp[1]).const_array();,
+                             Array4<Real const> const& az = area[2].fab(mfi,box,atmp[2]).const_array(););
                 AMREX_D_TERM(const Box& xbx = amrex::surroundingNodes(box,0);,
                              const Box& ybx = amrex::surroundingNodes(box,1);,
                              const Box& zbx = amrex::surroundingNodes(box,2););
@@ -899,6 +928,15 @@ MLEBABecLap::compGrad (int amrlev, const Array<MultiFab*,AMREX_SPACEDIM>& grad,
                     );
             }
         } else {
+           // The kernels read only the cut cell data of the box and its faces.
+           Array<FArrayBox,AMREX_SPACEDIM> atmp, ctmp;
+           AMREX_D_TERM(const FArrayBox& apxfab = area[0].fab(mfi,box,atmp[0]);,
+                        const FArrayBox& apyfab = area[1].fab(mfi,box,atmp[1]);,
+                        const FArrayBox& apzfab = area[2].fab(mfi,box,atmp[2]););
+           AMREX_D_TERM(const FArrayBox& fcxfab = fcent[0].fab(mfi,box,ctmp[0]);,
+                        const FArrayBox& fcyfab = fcent[1].fab(mfi,box,ctmp[1]);,
+                        const FArrayBox& fczfab = fcent[2].fab(mfi,box,ctmp[2]););
+
            amrex_mlebabeclap_grad(AMREX_D_DECL(BL_TO_FORTRAN_BOX(fbx[0]),
                                                BL_TO_FORTRAN_BOX(fbx[1]),
                                                BL_TO_FORTRAN_BOX(fbx[2])),
@@ -906,12 +944,12 @@ MLEBABecLap::compGrad (int amrlev, const Array<MultiFab*,AMREX_SPACEDIM>& grad,
                                   AMREX_D_DECL(BL_TO_FORTRAN_ANYD((*grad[0])[mfi]),
                                                BL_TO_FORTRAN_ANYD((*grad[1])[mfi]),
                                                BL_TO_FORTRAN_ANYD((*grad[2])[mfi])),
-                                  AMREX_D_DECL(BL_TO_FORTRAN_ANYD((*area[0])[mfi]),
-                                               BL_TO_FORTRAN_ANYD((*area[1])[mfi]),
-                                               BL_TO_FORTRAN_ANYD((*area[2])[mfi])),
-                                  AMREX_D_DECL(BL_TO_FORTRAN_ANYD((*fcent[0])[mfi]),
-                                               BL_TO_FORTRAN_ANYD((*fcent[1])[mfi]),
-                                               BL_TO_FORTRAN_ANYD((*fcent[2])[mfi])),
+                                  AMREX_D_DECL(BL_TO_FORTRAN_ANYD(apxfab),
+                                               BL_TO_FORTRAN_ANYD(apyfab),
+                                               BL_TO_FORTRAN_ANYD(apzfab)),
+                                  AMREX_D_DECL(BL_TO_FORTRAN_ANYD(fcxfab),
+                                               BL_TO_FORTRAN_ANYD(fcyfab),
+                                               BL_TO_FORTRAN_ANYD(fczfab)),
                                   BL_TO_FORTRAN_ANYD(ccmask[mfi]),
                                   BL_TO_FORTRAN_ANYD((*flags)[mfi]), dxinv, ncomp);
 
@@ -936,12 +974,10 @@ MLEBABecLap::normalize (int amrlev, int mglev, MultiFab& mf) const
     auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get());
     const FabArray<EBCellFlagFab>* flags = (factory) ? &(factory->getMultiEBCellFlagFab()) : nullptr;
     const MultiFab* vfrac = (factory) ? &(factory->getVolFrac()) : nullptr;
-    auto area = (factory) ? factory->getAreaFrac()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-    auto fcent = (factory) ? factory->getFaceCent()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
-    const MultiCutFab* barea = (factory) ? &(factory->getBndryArea()) : nullptr;
-    const MultiCutFab* bcent = (factory) ? &(factory->getBndryCent()) : nullptr;
+    auto area = (factory) ? factory->getAreaFracData() : Array<EBCutData,AMREX_SPACEDIM>{};
+    auto fcent = (factory) ? factory->getFaceCentData() : Array<EBCutData,AMREX_SPACEDIM>{};
+    const EBCutData barea = (factory) ? factory->getBndryAreaData() : EBCutData();
+    const EBCutData bcent = (factory) ? factory->getBndryCentData() : EBCutData();
 
     const int is_eb_dirichlet =  isEBDirichlet();
 
@@ -977,6 +1013,18 @@ MLEBABecLap::normalize (int amrlev, int mglev, MultiFab& mf) const
         {
             FArrayBox const& bebfab = (is_eb_dirichlet) ? (*m_eb_b_coeffs[amrlev][mglev])[mfi] : foo;
 
+            // The kernels read only the cut cell data of the box and its faces.
+            Array<FArrayBox,AMREX_SPACEDIM> atmp, ctmp;
+            AMREX_D_TERM(const FArrayBox& apxfab = area[0].fab(mfi,bx,atmp[0]);,
+                         const FArrayBox& apyfab = area[1].fab(mfi,bx,atmp[1]);,
+                         const FArrayBox& apzfab = area[2].fab(mfi,bx,atmp[2]););
+            AMREX_D_TERM(const FArrayBox& fcxfab = fcent[0].fab(mfi,bx,ctmp[0]);,
+                         const FArrayBox& fcyfab = fcent[1].fab(mfi,bx,ctmp[1]);,
+                         const FArrayBox& fczfab = fcent[2].fab(mfi,bx,ctmp[2]););
+            FArrayBox batmp, bctmp;
+            const FArrayBox& bafab = barea.fab(mfi,bx,batmp);
+            const FArrayBox& bcfab = bcent.fab(mfi,bx,bctmp);
+
             amrex_mlebabeclap_normalize(BL_TO_FORTRAN_BOX(bx),
                                         BL_TO_FORTRAN_ANYD(fab),
                                         BL_TO_FORTRAN_ANYD(afab),
@@ -986,14 +1034,14 @@ MLEBABecLap::normalize (int amrlev, int mglev, MultiFab& mf) const
                                         BL_TO_FORTRAN_ANYD(ccmask[mfi]),
                                         BL_TO_FORTRAN_ANYD((*flags)[mfi]),
                                         BL_TO_FORTRAN_ANYD((*vfrac)[mfi]),
-                                        AMREX_D_DECL(BL_TO_FORTRAN_ANYD((*area[0])[mfi]),
-                                                     BL_TO_FORTRAN_ANYD((*area[1])[mfi]),
-                                                     BL_TO_FORTRAN_ANYD((*area[2])[mfi])),
-                                        AMREX_D_DECL(BL_TO_FORTRAN_ANYD((*fcent[0])[mfi]),
-                                                     BL_TO_FORTRAN_ANYD((*fcent[1])[mfi]),
-                                                     BL_TO_FORTRAN_ANYD((*fcent[2])[mfi])),
-                                        BL_TO_FORTRAN_ANYD((*barea)[mfi]),
-                                        BL_TO_FORTRAN_ANYD((*bcent)[mfi]),
+                                        AMREX_D_DECL(BL_TO_FORTRAN_ANYD(apxfab),
+                                                     BL_TO_FORTRAN_ANYD(apyfab),
+                                                     BL_TO_FORTRAN_ANYD(apzfab)),
+                                        AMREX_D_DECL(BL_TO_FORTRAN_ANYD(fcxfab),
+                                                     BL_TO_FORTRAN_ANYD(fcyfab),
+                                                     BL_TO_FORTRAN_ANYD(fczfab)),
+                                        BL_TO_FORTRAN_ANYD(bafab),
+                                        BL_TO_FORTRAN_ANYD(bcfab),
                                         BL_TO_FORTRAN_ANYD(bebfab),
                                         is_eb_dirichlet,
                                         dxinv, m_a_scalar, m_b_scalar, ncomp);
@@ -1093,8 +1141,7 @@ MLEBABecLap::applyBC (int amrlev, int mglev, MultiFab& in, BCMode bc_mode, State
     
     auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get());
     const FabArray<EBCellFlagFab>* flags = (factory) ? &(factory->getMultiEBCellFlagFab()) : nullptr;
-    auto area = (factory) ? factory->getAreaFrac()
-        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
+    auto area = (factory) ? factory->getAreaFracData() : Array<EBCutData,AMREX_SPACEDIM>{};
     
     FArrayBox foofab(Box::TheUnitBox(),ncomp);
     const auto& foo = foofab.array();
@@ -1131,6 +1178,11 @@ MLEBABecLap::applyBC (int amrlev, int mglev, MultiFab& in, BCMode bc_mode, State
                 const auto& mhi = maskvals[ohi].array(mfi);
                 const auto& bvlo = (bndry != nullptr) ? bndry->bndryValues(olo).array(mfi) : foo;
                 const auto& bvhi = (bndry != nullptr) ? bndry->bndryValues(ohi).array(mfi) : foo;
+                FArrayBox aptmp;
+                Array4<Real const> ap = foo;
+                if (fabtyp != FabType::regular) {
+                    ap = area[idim].fab(mfi,amrex::grow(vbx,1),aptmp).const_array();
+                }
                 for (int icomp = 0; icomp < ncomp; ++icomp) {
                     const BoundCond bctlo = bdcv[icomp][olo];
                     const BoundCond bcthi = bdcv[icomp][ohi];
@@ -1178,7 +1230,6 @@ MLEBABecLap::applyBC (int amrlev, int mglev, MultiFab& in, BCMode bc_mode, State
                     }
                     else // irregular
                     {
-                        const auto& ap = area[idim]->const_array(mfi);
                         const auto& mask = ccmask.const_array(mfi);
                         if (idim == 0) {
                             AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
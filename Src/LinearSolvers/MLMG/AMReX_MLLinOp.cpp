@@ -73,6 +73,29 @@ namespace {
     std::unique_ptr<CommCache> comm_cache;
 #endif
 
+    bool sameInfo (const LPInfo& a, const LPInfo& b)
+    {
+        return a.do_agglomeration == b.do_agglomeration
+            && a.do_consolidation == b.do_consolidation
+            && a.agg_grid_size == b.agg_grid_size
+            && a.con_grid_size == b.con_grid_size
+            && a.has_metric_term == b.has_metric_term
+            && a.max_coarsening_level == b.max_coarsening_level;
+    }
+
+    bool sameGeometry (const Geometry& a, const Geometry& b)
+    {
+        if (a.Domain() != b.Domain() || a.Coord() != b.Coord()) return false;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (a.ProbLo(idim) != b.ProbLo(idim) || a.ProbHi(idim) != b.ProbHi(idim)
+                || a.isPeriodic(idim) != b.isPeriodic(idim))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     Vector<int> get_subgroup_ranks ()
     {
         int rank_n = ParallelContext::NProcsSub();
@@ -136,6 +159,7 @@ MLLinOp::define (const Vector<Geometry>& a_geom,
     }
 
     info = a_info;
+    m_define_info = a_info;
 #ifdef AMREX_USE_EB
     if (!a_factory.empty()){
         auto f = dynamic_cast<EBFArrayBoxFactory const*>(a_factory[0]);
@@ -150,6 +174,32 @@ MLLinOp::define (const Vector<Geometry>& a_geom,
     defineBC();
 }
 
+bool
+MLLinOp::isDefinedFor (const Vector<Geometry>& a_geom,
+                       const Vector<BoxArray>& a_grids,
+                       const Vector<DistributionMapping>& a_dmap,
+                       const LPInfo& a_info) const
+{
+    const int nlevs = a_geom.size();
+    if (m_geom.empty() || nlevs != m_num_amr_levels
+        || a_grids.size() < nlevs || a_dmap.size() < nlevs
+        || m_default_comm != ParallelContext::CommunicatorSub()
+        || !sameInfo(a_info, m_define_info))
+    {
+        return false;
+    }
+    for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev)
+    {
+        if (!sameGeometry(a_geom[amrlev], m_geom[amrlev][0])
+            || a_grids[amrlev] != m_grids[amrlev][0]
+            || a_dmap[amrlev] != m_dmap[amrlev][0])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 void
 MLLinOp::defineGrids (const Vector<Geometry>& a_geom,
                       const Vector<BoxArray>& a_grids,
@@ -462,6 +512,22 @@ MLLinOp::make (Vector<Vector<MultiFab> >& mf, int nc, int ng) const
     }
 }
 
+void
+MLLinOp::makeF (Vector<Vector<FloatMultiFab> >& mf, int nc, int ng) const
+{
+    mf.clear();
+    mf.resize(m_num_amr_levels);
+    for (int alev = 0; alev < m_num_amr_levels; ++alev)
+    {
+        mf[alev].resize(m_num_mg_levels[alev]);
+        for (int mlev = 1; mlev < m_num_mg_levels[alev]; ++mlev)
+        {
+            const auto& ba = amrex::convert(m_grids[alev][mlev], m_ixtype);
+            mf[alev][mlev].define(ba, m_dmap[alev][mlev], nc, ng);
+        }
+    }
+}
+
 void
 MLLinOp::setDomainBC (const Array<BCType,AMREX_SPACEDIM>& a_lobc,
                       const Array<BCType,AMREX_SPACEDIM>& a_hibc) noexcept
@@ -83,8 +83,10 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
     bool local = true;
     Real resnorm0 = MLResNormInf(finest_amr_lev, local); 
     Real rhsnorm0 = MLRhsNormInf(local); 
+    Real fine_norm0 = (namrlevs == 1) ? resnorm0 : ResNormInf(finest_amr_lev, local);
     if (!is_nsolve) {
-        ParallelAllReduce::Max<Real>({resnorm0, rhsnorm0}, ParallelContext::CommunicatorSub());
+        ParallelAllReduce::Max<Real>({resnorm0, rhsnorm0, fine_norm0},
+                                     ParallelContext::CommunicatorSub());
 
         if (verbose >= 1)
         {
@@ -104,6 +106,9 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
     }
     const Real res_target = std::max(a_tol_abs, std::max(a_tol_rel,1.e-16)*max_norm);
 
+    int iters_done = 0;
+    Real avg_rate = 0.0;
+
     if (!is_nsolve && resnorm0 <= res_target) {
         composite_norminf = resnorm0;
         if (verbose >= 1) {
@@ -113,9 +118,18 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
         Real iter_start_time = amrex::second();
         bool converged = false;
 
+        const bool adaptive = do_adaptive_cycle && !is_nsolve;
+        const int nu1_save = nu1;
+        const int nu2_save = nu2;
+        if (adaptive) initCycleTuning();
+
+        Real prev_norminf = fine_norm0;
+
         const int niters = do_fixed_number_of_iters ? do_fixed_number_of_iters : max_iters;
         for (int iter = 0; iter < niters; ++iter)
         {
+            Real t0 = amrex::second();
+
             oneIter(iter);
 
             converged = false;
@@ -125,7 +139,25 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
 
             if (is_nsolve) continue;
 
-            Real fine_norminf = ResNormInf(finest_amr_lev);
+            Real fine_norminf;
+            if (adaptive) {
+                // The iteration time is reduced with the norm so that all
+                // the processes make the same choice.
+                fine_norminf = ResNormInf(finest_amr_lev, local);
+                Real t = amrex::second() - t0;
+                ParallelAllReduce::Max<Real>({fine_norminf, t}, ParallelContext::CommunicatorSub());
+                // The first iteration mostly removes the high frequencies
+                // of the initial guess, so it would flatter its cycle.
+                ++cycle_iters[cycle_tuning.current];
+                if (iter > 0) {
+                    updateCycleTuning(t, fine_norminf/prev_norminf);
+                }
+            } else {
+                fine_norminf = ResNormInf(finest_amr_lev);
+            }
+            prev_norminf = fine_norminf;
+            iters_done = iter+1;
+
             composite_norminf = fine_norminf;
             if (verbose >= 2) {
                 amrex::Print() << "MLMG: Iteration " << std::setw(3) << iter+1 << " Fine resid/"
@@ -170,6 +202,13 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
             amrex::Abort("MLMG failed");
         }
         timer[iter_time] = amrex::second() - iter_start_time;
+
+        nu1 = nu1_save;
+        nu2 = nu2_save;
+
+        if (iters_done > 0) {
+            avg_rate = std::pow(prev_norminf/fine_norm0, 1.0/iters_done);
+        }
     }
 
     int ng_back = final_fill_bc ? 1 : 0;
@@ -190,6 +229,9 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
             amrex::AllPrint() << "MLMG: Timers: Solve = " << timer[solve_time]
                               << " Iter = " << timer[iter_time]
                               << " Bottom = " << timer[bottom_time] << "\n";
+            if (!is_nsolve && iters_done > 0) {
+                printSolveSummary(iters_done, avg_rate);
+            }
         }
     }
 
@@ -230,8 +272,17 @@ void MLMG::oneIter (int iter)
             makeSolvable(0,0,res[0][0]);
         }
 
-        if (iter < max_fmg_iters) {
+        CycleType cycle = cycle_type;
+        if (do_adaptive_cycle && cycle_tuning.current >= 0) {
+            cycle = cycle_tuning.candidates[cycle_tuning.current].type;
+        } else if (iter < max_fmg_iters) {
+            cycle = CycleType::F;
+        }
+
+        if (cycle == CycleType::F) {
             mgFcycle ();
+        } else if (cycle == CycleType::W) {
+            mgWcycle (0, 0);
         } else {
             mgVcycle (0, 0);
         }
@@ -398,10 +449,20 @@ MLMG::mgVcycle (int amrlev, int mglev_top)
 
     const int mglev_bottom = linop.NMGLevels(amrlev) - 1;
 
-    for (int mglev = mglev_top; mglev < mglev_bottom; ++mglev)
+    // With mixed precision, everything below the top MG level of the AMR
+    // level is done in single precision.
+    const bool mixed = use_mixed_precision && mglev_bottom > 0;
+    if (mixed && mglev_top > 0) {
+        mgVcycleF(amrlev, mglev_top);
+        return;
+    }
+    const int mglev_coarse = mixed ? 1 : mglev_bottom;
+
+    for (int mglev = mglev_top; mglev < mglev_coarse; ++mglev)
     {
         std::string blp_mgv_down_lev_str = make_str("MLMG::mgVcycle_down::", mglev);
         BL_PROFILE_VAR(blp_mgv_down_lev_str, blp_mgv_down_lev);
+        Real t0 = amrex::second();
 
         if (verbose >= 4)
         {
@@ -431,55 +492,64 @@ MLMG::mgVcycle (int amrlev, int mglev_top)
         // res_crse = R(rescor_fine); this provides res/b to the level below
         linop.restriction(amrlev, mglev+1, res[amrlev][mglev+1], rescor[amrlev][mglev]);
 
+        addLevelTime(amrlev, mglev, t0);
     }
 
-    BL_PROFILE_VAR("MLMG::mgVcycle_bottom", blp_bottom);
-    if (amrlev == 0)
+    if (mixed)
     {
-        if (verbose >= 4)
-        {
-            Real norm = res[amrlev][mglev_bottom].norm0();
-            amrex::Print() << "AT LEVEL "  << amrlev << " " << mglev_bottom
-                           << "   DN: Norm before bottom " << norm << "\n";
-        }
-        bottomSolve();
-        if (verbose >= 4)
-        {
-            computeResOfCorrection(amrlev, mglev_bottom);
-            Real norm = rescor[amrlev][mglev_bottom].norm0();
-            amrex::Print() << "AT LEVEL "  << amrlev << " " << mglev_bottom
-                           << "   UP: Norm after  bottom " << norm << "\n";
-        }
+        mgVcycleF(amrlev, mglev_coarse);
     }
     else
     {
-        if (verbose >= 4)
+        BL_PROFILE_VAR("MLMG::mgVcycle_bottom", blp_bottom);
+        if (amrlev == 0)
         {
-            Real norm = res[amrlev][mglev_bottom].norm0();
-            amrex::Print() << "AT LEVEL "  << amrlev << " " << mglev_bottom 
-                           << "       Norm before smooth " << norm << "\n";
-        }
-        cor[amrlev][mglev_bottom]->setVal(0.0);
-        bool skip_fillboundary = true;
-        for (int i = 0; i < nu1; ++i) {
-            linop.smooth(amrlev, mglev_bottom, *cor[amrlev][mglev_bottom], res[amrlev][mglev_bottom],
-                         skip_fillboundary);
-            skip_fillboundary = false;
+            if (verbose >= 4)
+            {
+                Real norm = res[amrlev][mglev_bottom].norm0();
+                amrex::Print() << "AT LEVEL "  << amrlev << " " << mglev_bottom
+                               << "   DN: Norm before bottom " << norm << "\n";
+            }
+            bottomSolve();
+            if (verbose >= 4)
+            {
+                computeResOfCorrection(amrlev, mglev_bottom);
+                Real norm = rescor[amrlev][mglev_bottom].norm0();
+                amrex::Print() << "AT LEVEL "  << amrlev << " " << mglev_bottom
+                               << "   UP: Norm after  bottom " << norm << "\n";
+            }
         }
-        if (verbose >= 4)
+        else
         {
-	    computeResOfCorrection(amrlev, mglev_bottom);
-            Real norm = rescor[amrlev][mglev_bottom].norm0();
-            amrex::Print() << "AT LEVEL "  << amrlev  << " " << mglev_bottom 
-                           << "       Norm after  smooth " << norm << "\n";
+            if (verbose >= 4)
+            {
+                Real norm = res[amrlev][mglev_bottom].norm0();
+                amrex::Print() << "AT LEVEL "  << amrlev << " " << mglev_bottom 
+                               << "       Norm before smooth " << norm << "\n";
+            }
+            cor[amrlev][mglev_bottom]->setVal(0.0);
+            bool skip_fillboundary = true;
+            for (int i = 0; i < nu1; ++i) {
+                linop.smooth(amrlev, mglev_bottom, *cor[amrlev][mglev_bottom], res[amrlev][mglev_bottom],
+                             skip_fillboundary);
+                skip_fillboundary = false;
+            }
+            if (verbose >= 4)
+            {
+                computeResOfCorrection(amrlev, mglev_bottom);
+                Real norm = rescor[amrlev][mglev_bottom].norm0();
+                amrex::Print() << "AT LEVEL "  << amrlev  << " " << mglev_bottom 
+                               << "       Norm after  smooth " << norm << "\n";
+            }
         }
+        BL_PROFILE_VAR_STOP(blp_bottom);
     }
-    BL_PROFILE_VAR_STOP(blp_bottom);
 
-    for (int mglev = mglev_bottom-1; mglev >= mglev_top; --mglev)
+    for (int mglev = mglev_coarse-1; mglev >= mglev_top; --mglev)
     {
         std::string blp_mgv_up_lev_str = make_str("MLMG::mgVcycle_up::", mglev);
         BL_PROFILE_VAR(blp_mgv_up_lev_str, blp_mgv_up_lev);
+        Real t0 = amrex::second();
         // cor_fine += I(cor_crse)
         addInterpCorrection(amrlev, mglev);
         if (verbose >= 4)
@@ -502,7 +572,83 @@ MLMG::mgVcycle (int amrlev, int mglev_top)
             amrex::Print() << "AT LEVEL "  << amrlev << " " << mglev
                            << "   UP: Norm after  smooth " << norm << "\n";
         }
+
+        addLevelTime(amrlev, mglev, t0);
+    }
+}
+
+// Single precision V-cycle on the coarsened MG levels.
+// in   : Residual (res) on mglev_top > 0
+// out  : Correction (cor) on mglev_top
+void
+MLMG::mgVcycleF (int amrlev, int mglev_top)
+{
+    BL_PROFILE("MLMG::mgVcycleF()");
+
+    const int ncomp = linop.getNComp();
+    const int mglev_bottom = linop.NMGLevels(amrlev) - 1;
+
+    MLLinOp::copyConvert(res_f[amrlev][mglev_top], res[amrlev][mglev_top], ncomp);
+
+    for (int mglev = mglev_top; mglev < mglev_bottom; ++mglev)
+    {
+        std::string blp_mgv_down_lev_str = make_str("MLMG::mgVcycleF_down::", mglev);
+        BL_PROFILE_VAR(blp_mgv_down_lev_str, blp_mgv_down_lev);
+        Real t0 = amrex::second();
+
+        cor_f[amrlev][mglev].setVal(0.0);
+        bool skip_fillboundary = true;
+        for (int i = 0; i < nu1; ++i) {
+            linop.smoothF(amrlev, mglev, cor_f[amrlev][mglev], res_f[amrlev][mglev],
+                          skip_fillboundary);
+            skip_fillboundary = false;
+        }
+
+        // rescor = res - L(cor)
+        linop.correctionResidualF(amrlev, mglev, rescor_f[amrlev][mglev],
+                                  cor_f[amrlev][mglev], res_f[amrlev][mglev]);
+
+        // res_crse = R(rescor_fine)
+        linop.restrictionF(amrlev, mglev+1, res_f[amrlev][mglev+1], rescor_f[amrlev][mglev]);
+
+        addLevelTime(amrlev, mglev, t0);
+    }
+
+    BL_PROFILE_VAR("MLMG::mgVcycle_bottom", blp_bottom);
+    if (amrlev == 0)
+    {
+        // The bottom problem is small, so it is solved in double precision.
+        MLLinOp::copyConvert(res[amrlev][mglev_bottom], res_f[amrlev][mglev_bottom], ncomp);
+        bottomSolve();
+        MLLinOp::copyConvert(cor_f[amrlev][mglev_bottom], *cor[amrlev][mglev_bottom], ncomp);
+    }
+    else
+    {
+        cor_f[amrlev][mglev_bottom].setVal(0.0);
+        bool skip_fillboundary = true;
+        for (int i = 0; i < nu1; ++i) {
+            linop.smoothF(amrlev, mglev_bottom, cor_f[amrlev][mglev_bottom],
+                          res_f[amrlev][mglev_bottom], skip_fillboundary);
+            skip_fillboundary = false;
+        }
     }
+    BL_PROFILE_VAR_STOP(blp_bottom);
+
+    for (int mglev = mglev_bottom-1; mglev >= mglev_top; --mglev)
+    {
+        std::string blp_mgv_up_lev_str = make_str("MLMG::mgVcycleF_up::", mglev);
+        BL_PROFILE_VAR(blp_mgv_up_lev_str, blp_mgv_up_lev);
+        Real t0 = amrex::second();
+        // cor_fine += I(cor_crse)
+        addInterpCorrectionF(amrlev, mglev);
+        for (int i = 0; i < nu2; ++i) {
+            linop.smoothF(amrlev, mglev, cor_f[amrlev][mglev], res_f[amrlev][mglev]);
+        }
+
+        addLevelTime(amrlev, mglev, t0);
+    }
+
+    MLLinOp::copyConvert(*cor[amrlev][mglev_top], cor_f[amrlev][mglev_top], ncomp);
 }
 
 // FMG cycle on the coarsest AMR level.
@@ -522,14 +668,18 @@ MLMG::mgFcycle ()
 
     for (int mglev = 1; mglev <= mg_bottom_lev; ++mglev)
     {
+        Real t0 = amrex::second();
         // TODO: for EB cell-centered, we need to use EB_average_down
         amrex::average_down(res[amrlev][mglev-1], res[amrlev][mglev], 0, ncomp, ratio);
+        addLevelTime(amrlev, mglev-1, t0);
     }
 
     bottomSolve();
 
     for (int mglev = mg_bottom_lev-1; mglev >= 0; --mglev)
     {
+        Real t0 = amrex::second();
+
         // cor_fine = I(cor_crse)
         interpCorrection (amrlev, mglev);
 
@@ -538,6 +688,8 @@ MLMG::mgFcycle ()
         // res = rescor; this provides b to the vcycle below
         MultiFab::Copy(res[amrlev][mglev], rescor[amrlev][mglev], 0,0,ncomp,nghost);
 
+        addLevelTime(amrlev, mglev, t0);
+
         // save cor; do v-cycle; add the saved to cor
         std::swap(cor[amrlev][mglev], cor_hold[amrlev][mglev]);
         mgVcycle(amrlev, mglev);
@@ -545,6 +697,77 @@ MLMG::mgFcycle ()
     }
 }
 
+// W-cycle on the coarsest AMR level.  Every coarsened MG level above the
+// bottom is cycled twice for each visit of the level above it.
+// in   : Residual (res) on mglev
+// out  : Correction (cor) on mglev
+void
+MLMG::mgWcycle (int amrlev, int mglev)
+{
+    BL_PROFILE("MLMG::mgWcycle()");
+
+    const int mglev_bottom = linop.NMGLevels(amrlev) - 1;
+    if (mglev == mglev_bottom) {
+        mgVcycle(amrlev, mglev);
+        return;
+    }
+
+    const int ncomp = linop.getNComp();
+    int nghost = 0;
+    if (cf_strategy == CFStrategy::ghostnodes) nghost = linop.getNGrow();
+
+    const int mglev_crse = mglev+1;
+
+    Real t0 = amrex::second();
+
+    cor[amrlev][mglev]->setVal(0.0);
+    bool skip_fillboundary = true;
+    for (int i = 0; i < nu1; ++i) {
+        linop.smooth(amrlev, mglev, *cor[amrlev][mglev], res[amrlev][mglev],
+                     skip_fillboundary);
+        skip_fillboundary = false;
+    }
+
+    // rescor = res - L(cor)
+    computeResOfCorrection(amrlev, mglev);
+
+    // res_crse = R(rescor_fine); this provides res/b to the level below
+    linop.restriction(amrlev, mglev_crse, res[amrlev][mglev_crse], rescor[amrlev][mglev]);
+
+    addLevelTime(amrlev, mglev, t0);
+
+    mgWcycle(amrlev, mglev_crse);
+
+    // Solving the bottom problem twice would not help.
+    if (mglev_crse < mglev_bottom)
+    {
+        t0 = amrex::second();
+
+        // res_crse = rescor_crse; the second cycle works on what the first left
+        computeResOfCorrection(amrlev, mglev_crse);
+        MultiFab::Copy(res[amrlev][mglev_crse], rescor[amrlev][mglev_crse], 0, 0, ncomp, nghost);
+
+        addLevelTime(amrlev, mglev_crse, t0);
+
+        // save cor; do w-cycle; add the saved to cor
+        std::swap(cor[amrlev][mglev_crse], cor_hold[amrlev][mglev_crse]);
+        mgWcycle(amrlev, mglev_crse);
+        MultiFab::Add(*cor[amrlev][mglev_crse], *cor_hold[amrlev][mglev_crse], 0, 0, ncomp, nghost);
+    }
+
+    t0 = amrex::second();
+
+    // cor_fine += I(cor_crse)
+    addInterpCorrection(amrlev, mglev);
+    for (int i = 0; i < nu2; ++i) {
+        linop.smooth(amrlev, mglev, *cor[amrlev][mglev], res[amrlev][mglev]);
+    }
+
+    if (cf_strategy == CFStrategy::ghostnodes) computeResOfCorrection(amrlev, mglev);
+
+    addLevelTime(amrlev, mglev, t0);
+}
+
 // Interpolate correction from coarse to fine AMR level.
 void
 MLMG::interpCorrection (int alev)
@@ -846,6 +1069,37 @@ MLMG::addInterpCorrection (int alev, int mglev)
     linop.interpolation(alev, mglev, fine_cor, *cmf);
 }
 
+void
+MLMG::addInterpCorrectionF (int alev, int mglev)
+{
+    BL_PROFILE("MLMG::addInterpCorrectionF()");
+
+    const int ncomp = linop.getNComp();
+
+    const MLLinOp::FloatMultiFab& crse_cor = cor_f[alev][mglev+1];
+    MLLinOp::FloatMultiFab&       fine_cor = cor_f[alev][mglev  ];
+
+    const int refratio = 2;
+    MLLinOp::FloatMultiFab cfine;
+    const MLLinOp::FloatMultiFab* cmf;
+
+    if (amrex::isMFIterSafe(crse_cor, fine_cor))
+    {
+        cmf = &crse_cor;
+    }
+    else
+    {
+        BoxArray cba = fine_cor.boxArray();
+        cba.coarsen(refratio);
+        const int ng = 0;
+        cfine.define(cba, fine_cor.DistributionMap(), ncomp, ng);
+        cfine.ParallelCopy(crse_cor);
+        cmf = &cfine;
+    }
+
+    linop.interpolationF(alev, mglev, fine_cor, *cmf);
+}
+
 // Compute rescor = res - L(cor)
 // in   : res
 // inout: cor (out due to FillBoundary in linop.correctionResidual)
@@ -942,12 +1196,27 @@ MLMG::actualBottomSolve ()
         {
             bottomSolveWithPETSc(x, *bottom_b);
         }
+        else if (bottom_solver == BottomSolver::amg)
+        {
+            int ret = bottomSolveWithAMG(x, *bottom_b);
+            if (ret != 0) {
+                cor[amrlev][mglev]->setVal(0.0);
+            }
+            const int n = (ret==0) ? nub : nuf;
+            for (int i = 0; i < n; ++i) {
+                linop.smooth(amrlev, mglev, x, b);
+            }
+        }
         else
         {
             MLCGSolver::Type cg_type;
             if (bottom_solver == BottomSolver::cg ||
                 bottom_solver == BottomSolver::cgbicg) {
                 cg_type = MLCGSolver::Type::CG;
+            } else if (bottom_solver == BottomSolver::pipelined_cg) {
+                cg_type = MLCGSolver::Type::PipelinedCG;
+            } else if (bottom_solver == BottomSolver::pipelined_bicgstab) {
+                cg_type = MLCGSolver::Type::PipelinedBiCGStab;
             } else {
                 cg_type = MLCGSolver::Type::BiCGStab;
             }
@@ -1134,7 +1403,7 @@ MLMG::prepareForSolve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab con
     AMREX_ASSERT(namrlevs <= a_sol.size());
     AMREX_ASSERT(namrlevs <= a_rhs.size());
 
-    timer.assign(ntimers, 0.0);
+    timer.assign(ntimers + linop.NMGLevels(0), 0.0);
 
     const int ncomp = linop.getNComp();
     int nghost = 0;
@@ -1147,6 +1416,12 @@ MLMG::prepareForSolve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab con
         linop.update();
     }
 
+    use_mixed_precision = do_mixed_precision && linop.supportsMixedPrecision()
+        && cf_strategy == CFStrategy::none;
+    if (use_mixed_precision) {
+        linop.prepareMixedPrecision();
+    }
+
 #ifdef AMREX_USE_HYPRE
     hypre_solver.reset();
     hypre_bndry.reset();
@@ -1158,6 +1433,8 @@ MLMG::prepareForSolve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab con
     petsc_bndry.reset(); 
 #endif
 
+    amg_solver.reset();
+
     sol.resize(namrlevs);
     sol_raii.resize(namrlevs);
     for (int alev = 0; alev < namrlevs; ++alev)
@@ -1250,6 +1527,13 @@ MLMG::prepareForSolve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab con
         }
     }
 
+    if (use_mixed_precision && res_f.empty())
+    {
+        linop.makeF(res_f, ncomp, 0);
+        linop.makeF(rescor_f, ncomp, 0);
+        linop.makeF(cor_f, ncomp, 1);
+    }
+
     cor_hold.resize(std::max(namrlevs-1,1));
     {
         const int alev = 0;
@@ -1852,6 +2136,173 @@ MLMG::bottomSolveWithPETSc (MultiFab& x, const MultiFab& b)
 #endif
 }
 
+int
+MLMG::bottomSolveWithAMG (MultiFab& x, const MultiFab& b)
+{
+    BL_PROFILE("MLMG::bottomSolveWithAMG()");
+
+    const int ncomp = linop.getNComp();
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(ncomp == 1, "bottomSolveWithAMG doesn't work with ncomp > 1");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(cf_strategy == CFStrategy::none,
+                                     "bottomSolveWithAMG doesn't work with ghostnodes");
+
+    if (amg_solver == nullptr)  // The setup is reused until the next prepareForSolve.
+    {
+        amg_solver.reset(new MLAMGSolver(linop, b));
+        amg_solver->setVerbose(bottom_verbose);
+        amg_solver->setMaxIter(bottom_maxiter);
+    }
+
+    int ret = amg_solver->solve(x, b, bottom_reltol, bottom_abstol);
+    if (ret != 0 && verbose > 1) {
+        amrex::Print() << "MLMG: Bottom solve failed.\n";
+    }
+    return ret;
+}
+
+namespace {
+
+constexpr int max_cycle_nu = 4;
+
+int cycle_index (MLMG::CycleType c, int nu)
+{
+    return static_cast<int>(c)*max_cycle_nu + nu-1;
+}
+
+std::string cycle_name (MLMG::CycleType c, int n1, int n2)
+{
+    const char* t = (c == MLMG::CycleType::V) ? "V" : ((c == MLMG::CycleType::W) ? "W" : "F");
+    return make_str(t, "(", n1, ",", n2, ")");
+}
+
+}
+
+void
+MLMG::initCycleTuning ()
+{
+    auto& cands = cycle_tuning.candidates;
+    if (cands.empty())
+    {
+        for (CycleType c : {CycleType::V, CycleType::W, CycleType::F}) {
+            for (int nu = 1; nu <= max_cycle_nu; ++nu) {
+                cands.push_back({c, nu, 0, 0.0, 0.0});
+            }
+        }
+        // Start from what the user asked for.
+        const CycleType c = (max_fmg_iters > 0) ? CycleType::F : cycle_type;
+        const int nu = std::max(1, std::min(max_cycle_nu, (nu1+nu2+1)/2));
+        cycle_tuning.current = cycle_index(c, nu);
+    }
+    cycle_iters.assign(cands.size(), 0);
+    nu1 = nu2 = cands[cycle_tuning.current].nu;
+}
+
+// Record the time and the convergence factor of the last iteration, and
+// pick the cycle for the next one.
+void
+MLMG::updateCycleTuning (Real a_iter_time, Real a_rate)
+{
+    auto& cands = cycle_tuning.candidates;
+    auto& cur = cands[cycle_tuning.current];
+
+    // An iteration that makes no progress gets a large but finite cost.
+    const Real digits = std::max(-std::log10(std::max(a_rate, Real(1.e-16))), Real(1.e-3));
+    const Real cost = a_iter_time / digits;
+    if (cur.count == 0) {
+        cur.cost = cost;
+        cur.rate = a_rate;
+    } else {
+        cur.cost = 0.5*(cur.cost + cost);
+        cur.rate = 0.5*(cur.rate + a_rate);
+    }
+    ++cur.count;
+
+    // Move to the cheapest candidate measured so far, unless one of its
+    // neighbors (another cycle type, or one sweep more or less) has not
+    // been tried yet.
+    int best = cycle_tuning.current;
+    for (int i = 0, N = cands.size(); i < N; ++i) {
+        if (cands[i].count > 0 && cands[i].cost < cands[best].cost) best = i;
+    }
+
+    const CycleType btype = cands[best].type;
+    const int bnu = cands[best].nu;
+    Vector<int> nbrs;
+    for (CycleType c : {CycleType::V, CycleType::W, CycleType::F}) {
+        if (c != btype) nbrs.push_back(cycle_index(c, bnu));
+    }
+    if (bnu > 1) nbrs.push_back(cycle_index(btype, bnu-1));
+    if (bnu < max_cycle_nu) nbrs.push_back(cycle_index(btype, bnu+1));
+
+    int next = best;
+    for (int i : nbrs) {
+        if (cands[i].count == 0) {
+            next = i;
+            break;
+        }
+    }
+
+    cycle_tuning.current = next;
+    nu1 = nu2 = cands[next].nu;
+}
+
+// Called on the first process of the communicator after the timers have
+// been reduced.
+void
+MLMG::printSolveSummary (int niters, Real rate) const
+{
+    std::ostringstream oss;
+    oss << "MLMG: Avg. convergence factor = " << rate
+        << ", time per iteration = " << timer[iter_time]/niters << ", cycle = ";
+    if (do_adaptive_cycle && !cycle_iters.empty())
+    {
+        const auto& cands = cycle_tuning.candidates;
+        bool first = true;
+        for (int i = 0, N = cands.size(); i < N; ++i) {
+            if (cycle_iters[i] > 0) {
+                oss << (first ? "" : ", ") << cycle_name(cands[i].type, cands[i].nu, cands[i].nu)
+                    << " x " << cycle_iters[i];
+                first = false;
+            }
+        }
+    }
+    else if (max_fmg_iters > 0 && cycle_type != CycleType::F)
+    {
+        oss << cycle_name(CycleType::F, nu1, nu2) << " x " << std::min(max_fmg_iters, niters);
+        if (niters > max_fmg_iters) {
+            oss << ", " << cycle_name(cycle_type, nu1, nu2) << " x " << niters-max_fmg_iters;
+        }
+    }
+    else
+    {
+        oss << cycle_name(cycle_type, nu1, nu2);
+    }
+    amrex::AllPrint() << oss.str() << "\n";
+
+    if (verbose >= 2)
+    {
+        std::ostringstream os2;
+        os2 << "MLMG: Time per MG level =";
+        const int nmglevs = timer.size() - level_time;
+        for (int mglev = 0; mglev < nmglevs-1; ++mglev) {
+            os2 << " " << mglev << ": " << timer[level_time+mglev];
+        }
+        os2 << " bottom: " << timer[bottom_time];
+        amrex::AllPrint() << os2.str() << "\n";
+
+        if (do_adaptive_cycle)
+        {
+            for (const auto& c : cycle_tuning.candidates) {
+                if (c.count > 0) {
+                    amrex::AllPrint() << "MLMG:   " << cycle_name(c.type, c.nu, c.nu)
+                                      << ": " << c.cost << " s per digit, convergence factor "
+                                      << c.rate << ", " << c.count << " samples\n";
+                }
+            }
+        }
+    }
+}
+
 void
 MLMG::checkPoint (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rhs,
                   Real a_tol_rel, Real a_tol_abs, const char* a_file_name) const
@@ -1,5 +1,6 @@
 #include <AMReX_ParticleCommunication.H>
 #include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParticleMPIUtil.H>
 
 using namespace amrex;
 
@@ -243,6 +244,12 @@ void ParticleCopyPlan::doHandShakeLocal (const Vector<long>& Snds, Vector<long>&
 void ParticleCopyPlan::doHandShakeGlobal (const Vector<long>& Snds, Vector<long>& Rcvs) const
 {
 #ifdef BL_USE_MPI
+    if (useNBXHandShake())
+    {
+        doHandShakeNBX(Snds, Rcvs, ParallelDescriptor::Communicator());
+        return;
+    }
+
     const int SeqNum = ParallelDescriptor::SeqNum();
     const int NProcs = ParallelDescriptor::NProcs();
 
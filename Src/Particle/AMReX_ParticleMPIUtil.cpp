@@ -1,8 +1,12 @@
 #include <AMReX_ParticleMPIUtil.H>
 
 #include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
 #include <AMReX_BLProfiler.H>
 
+#include <algorithm>
+#include <utility>
+
 namespace amrex {
 
 #ifdef BL_USE_MPI    
@@ -24,6 +28,31 @@ namespace amrex {
     long doHandShake(const std::map<int, Vector<char> >& not_ours,
                      Vector<long>& Snds, Vector<long>& Rcvs)
     {
+        if (useNBXHandShake())
+        {
+            Vector<int> snd_procs, rcv_procs;
+            Vector<long> snd_counts, rcv_counts;
+            long NumSnds = 0;
+            for (const auto& kv : not_ours)
+            {
+                if (kv.second.empty()) continue;
+                NumSnds       += kv.second.size();
+                Snds[kv.first] = kv.second.size();
+                snd_procs.push_back(kv.first);
+                snd_counts.push_back(kv.second.size());
+            }
+
+            doHandShakeNBX(snd_procs, snd_counts, rcv_procs, rcv_counts,
+                           ParallelDescriptor::Communicator());
+
+            for (int i = 0, N = rcv_procs.size(); i < N; ++i)
+            {
+                Rcvs[rcv_procs[i]] = rcv_counts[i];
+                NumSnds += rcv_counts[i];
+            }
+            return NumSnds;
+        }
+
         long NumSnds = CountSnds(not_ours, Snds);
         if (NumSnds == 0) return NumSnds;
 
@@ -89,6 +118,108 @@ namespace amrex {
         
         return NumSnds;
     }
+
+    void doHandShakeNBX (const Vector<int>& snd_procs, const Vector<long>& snd_counts,
+                         Vector<int>& rcv_procs, Vector<long>& rcv_counts, MPI_Comm comm)
+    {
+        BL_PROFILE("doHandShakeNBX()");
+
+        AMREX_ASSERT(snd_procs.size() == snd_counts.size());
+
+        const int SeqNum = ParallelDescriptor::SeqNum();
+        const MPI_Datatype mpi_long = ParallelDescriptor::Mpi_typemap<long>::type();
+
+        // Synchronous sends complete only when they have been received.
+        const int nsnds = snd_procs.size();
+        Vector<MPI_Request> sreqs(nsnds);
+        for (int i = 0; i < nsnds; ++i)
+        {
+            BL_ASSERT(snd_counts[i] > 0);
+            BL_MPI_REQUIRE( MPI_Issend(const_cast<long*>(&snd_counts[i]), 1, mpi_long,
+                                       snd_procs[i], SeqNum, comm, &sreqs[i]) );
+        }
+
+        // Receive until every process has entered the barrier, which each
+        // does once all of its own sends have been received.
+        Vector<std::pair<int,long> > rcvd;
+        MPI_Request barrier_req = MPI_REQUEST_NULL;
+        bool in_barrier = false;
+        int done = 0;
+        while (!done)
+        {
+            int flag;
+            MPI_Status status;
+            BL_MPI_REQUIRE( MPI_Iprobe(MPI_ANY_SOURCE, SeqNum, comm, &flag, &status) );
+            if (flag)
+            {
+                long cnt;
+                BL_MPI_REQUIRE( MPI_Recv(&cnt, 1, mpi_long, status.MPI_SOURCE, SeqNum,
+                                         comm, MPI_STATUS_IGNORE) );
+                rcvd.push_back(std::make_pair(status.MPI_SOURCE, cnt));
+            }
+
+            if (in_barrier)
+            {
+                BL_MPI_REQUIRE( MPI_Test(&barrier_req, &done, MPI_STATUS_IGNORE) );
+            }
+            else
+            {
+                int all_sent;
+                BL_MPI_REQUIRE( MPI_Testall(nsnds, sreqs.dataPtr(), &all_sent,
+                                            MPI_STATUSES_IGNORE) );
+                if (all_sent)
+                {
+                    BL_MPI_REQUIRE( MPI_Ibarrier(comm, &barrier_req) );
+                    in_barrier = true;
+                }
+            }
+        }
+
+        std::sort(rcvd.begin(), rcvd.end());
+        rcv_procs.resize(rcvd.size());
+        rcv_counts.resize(rcvd.size());
+        for (int i = 0, N = rcvd.size(); i < N; ++i)
+        {
+            rcv_procs[i] = rcvd[i].first;
+            rcv_counts[i] = rcvd[i].second;
+        }
+    }
+
+    void doHandShakeNBX (const Vector<long>& Snds, Vector<long>& Rcvs, MPI_Comm comm)
+    {
+        Vector<int> snd_procs, rcv_procs;
+        Vector<long> snd_counts, rcv_counts;
+        for (int i = 0, N = Snds.size(); i < N; ++i)
+        {
+            if (Snds[i] > 0)
+            {
+                snd_procs.push_back(i);
+                snd_counts.push_back(Snds[i]);
+            }
+        }
+
+        doHandShakeNBX(snd_procs, snd_counts, rcv_procs, rcv_counts, comm);
+
+        std::fill(Rcvs.begin(), Rcvs.end(), 0L);
+        for (int i = 0, N = rcv_procs.size(); i < N; ++i)
+        {
+            Rcvs[rcv_procs[i]] = rcv_counts[i];
+        }
+    }
+
+    bool useNBXHandShake ()
+    {
+        static bool use_nbx = true;
+        static bool first = true;
+        if (first)
+        {
+            first = false;
+            ParmParse pp("particles");
+            pp.query("use_nbx_handshake", use_nbx);
+        }
+        return use_nbx;
+    }
+
 #endif  // BL_USE_MPI
 
 }
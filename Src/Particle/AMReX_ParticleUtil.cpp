@@ -51,4 +51,25 @@ int getTileIndex (const IntVect& iv, const Box& box, const bool a_do_tiling,
     }
 }
 
+void countingSortPermutation (const Vector<int>& bins, int nbins,
+                              Vector<int>& perm, Vector<int>& offsets)
+{
+    const int n = bins.size();
+
+    offsets.assign(nbins+1, 0);
+    for (int i = 0; i < n; ++i) {
+        AMREX_ASSERT(bins[i] >= 0 && bins[i] < nbins);
+        ++offsets[bins[i]+1];
+    }
+    for (int b = 0; b < nbins; ++b) {
+        offsets[b+1] += offsets[b];
+    }
+
+    Vector<int> pos(offsets.begin(), offsets.end()-1);
+    perm.resize(n);
+    for (int i = 0; i < n; ++i) {
+        perm[pos[bins[i]]++] = i;
+    }
+}
+
 }
@@ -0,0 +1,127 @@
+#include <AMReX.H>
+#include <AMReX_Print.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
+#include <AMReX_CArena.H>
+#include <AMReX_SArena.H>
+
+#include <memory>
+#include <iomanip>
+#include <cstring>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace amrex;
+
+//
+// Emulate the short-lived temporaries allocated inside MFIter loops:
+// each thread repeatedly allocates a set of buffers of mixed sizes,
+// touches them, and frees them again.
+//
+namespace {
+
+    int nrounds = 200;
+    int nlive = 64;
+    long max_bytes = 262144;
+
+    template <class F, class G>
+    double run (int nthreads, F&& allocf, G&& freef)
+    {
+        double t0 = amrex::second();
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nthreads)
+#endif
+        {
+            int tid = 0;
+#ifdef _OPENMP
+            tid = omp_get_thread_num();
+#endif
+            Vector<void*> ptrs(nlive);
+            unsigned long seed = 12345 + 7919*tid;
+            for (int r = 0; r < nrounds; ++r)
+            {
+                for (int i = 0; i < nlive; ++i) {
+                    seed = seed*6364136223846793005UL + 1442695040888963407UL;
+                    std::size_t nbytes = 8 + (seed >> 33) % max_bytes;
+                    ptrs[i] = allocf(tid, nbytes);
+                    std::memset(ptrs[i], 0, 8);
+                }
+                for (int i = nlive-1; i >= 0; --i) {
+                    freef(tid, ptrs[i]);
+                }
+            }
+        }
+        return amrex::second() - t0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        ParmParse pp;
+        pp.query("nrounds", nrounds);
+        pp.query("nlive", nlive);
+        pp.query("max_bytes", max_bytes);
+
+        Vector<int> nthreads_list {1, 2, 4, 8, 16, 32, 64};
+        pp.queryarr("nthreads", nthreads_list);
+
+        amrex::Print() << "Arena benchmark: " << nrounds << " rounds of " << nlive
+                       << " temporaries of up to " << max_bytes << " bytes per thread\n\n";
+        amrex::Print() << "  nthreads   shared CArena   per-thread CArena      SArena     speedup\n";
+
+        // With more threads, SArena would use its depot directly instead
+        // of the magazines being measured.
+        const int max_threads = SArena().numThreadCaches();
+
+        for (int nthreads : nthreads_list)
+        {
+            if (nthreads > max_threads) {
+                amrex::Print() << "  " << std::setw(8) << nthreads
+                               << "  skipped: SArena has thread caches for "
+                               << max_threads << " threads\n";
+                continue;
+            }
+
+            // One CArena shared by all threads, like The_Arena().
+            double t_shared;
+            {
+                CArena arena;
+                t_shared = run(nthreads,
+                               [&] (int, std::size_t n) { return arena.alloc(n); },
+                               [&] (int, void* p) { arena.free(p); });
+            }
+
+            // One CArena per thread, like the original amrex_mempool.
+            double t_private;
+            {
+                Vector<std::unique_ptr<CArena> > arenas(nthreads);
+                for (auto& a : arenas) a.reset(new CArena);
+                t_private = run(nthreads,
+                                [&] (int tid, std::size_t n) { return arenas[tid]->alloc(n); },
+                                [&] (int tid, void* p) { arenas[tid]->free(p); });
+            }
+
+            double t_sarena;
+            long nmisses;
+            {
+                SArena arena;
+                t_sarena = run(nthreads,
+                               [&] (int, std::size_t n) { return arena.alloc(n); },
+                               [&] (int, void* p) { arena.free(p); });
+                nmisses = arena.numMisses();
+            }
+
+            amrex::Print() << "  " << std::setw(8) << nthreads
+                           << "  " << std::setw(14) << t_shared
+                           << "  " << std::setw(18) << t_private
+                           << "  " << std::setw(10) << t_sarena
+                           << "  " << std::setw(10) << t_private/t_sarena
+                           << "   (SArena misses: " << nmisses << ")\n";
+        }
+    }
+    amrex::Finalize();
+}
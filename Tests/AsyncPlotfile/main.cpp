@@ -0,0 +1,150 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_PlotFileUtil.H>
+
+using namespace amrex;
+
+//
+// Advance a two-level hierarchy with a dummy kernel and write a plotfile
+// every plot_int steps, first with WriteMultiLevelPlotfile and then with
+// AsyncPlotfileWriter.  The last plotfiles of the two runs are compared.
+//
+
+namespace {
+
+void advance (Vector<MultiFab>& mf, int work)
+{
+    for (auto& m : mf) {
+        for (int w = 0; w < work; ++w) {
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(m,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                const Box& bx = mfi.tilebox();
+                const int ncomp = m.nComp();
+                auto const& a = m.array(mfi);
+                amrex::ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+                {
+                    a(i,j,k,n) = 0.5*a(i,j,k,n) + 0.25*(n+1);
+                });
+            }
+        }
+    }
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        BL_PROFILE("main");
+
+        int n_cell = 128;
+        int max_grid_size = 32;
+        int ncomp = 4;
+        int nsteps = 10;
+        int plot_int = 2;
+        int work = 20;
+        int max_in_flight = 2;
+        bool single_precision = false;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("ncomp", ncomp);
+            pp.query("nsteps", nsteps);
+            pp.query("plot_int", plot_int);
+            pp.query("work", work);
+            pp.query("max_in_flight", max_in_flight);
+            pp.query("single_precision", single_precision);
+        }
+
+        const int nlevels = 2;
+        Vector<Geometry> geom(nlevels);
+        Vector<BoxArray> ba(nlevels);
+        Vector<DistributionMapping> dm(nlevels);
+        Vector<IntVect> ref_ratio(nlevels-1, IntVect(AMREX_D_DECL(2,2,2)));
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Box domain(IntVect(0), IntVect(n_cell-1));
+        for (int lev = 0; lev < nlevels; ++lev) {
+            geom[lev].define(domain, &rb, CoordSys::cartesian);
+            if (lev == 0) {
+                ba[lev].define(domain);
+            } else {
+                // refine the middle of the domain; domain is already refined here
+                ba[lev].define(amrex::grow(domain,-n_cell/2));
+            }
+            ba[lev].maxSize(max_grid_size);
+            dm[lev].define(ba[lev]);
+            domain.refine(ref_ratio[0]);
+        }
+
+        Vector<std::string> varnames;
+        for (int n = 0; n < ncomp; ++n) {
+            varnames.push_back("v" + std::to_string(n));
+        }
+
+        Vector<Real> t_run(2);
+        std::string last_plotfile[2];
+        for (int async = 0; async < 2; ++async)
+        {
+            Vector<MultiFab> mf(nlevels);
+            for (int lev = 0; lev < nlevels; ++lev) {
+                mf[lev].define(ba[lev], dm[lev], ncomp, 1);
+                mf[lev].setVal(1.0);
+            }
+            Vector<const MultiFab*> pmf {&mf[0], &mf[1]};
+
+            std::unique_ptr<AsyncPlotfileWriter> writer;
+            if (async) writer.reset(new AsyncPlotfileWriter(max_in_flight, single_precision));
+
+            ParallelDescriptor::Barrier();
+            Real t0 = amrex::second();
+            for (int step = 1; step <= nsteps; ++step)
+            {
+                advance(mf, work);
+                if (step % plot_int == 0) {
+                    last_plotfile[async] = amrex::Concatenate(async ? "plt_async" : "plt_sync", step);
+                    Vector<int> level_steps(nlevels, step);
+                    if (async) {
+                        writer->write(last_plotfile[async], nlevels, pmf, varnames, geom,
+                                      Real(step), level_steps, ref_ratio);
+                    } else {
+                        WriteMultiLevelPlotfile(last_plotfile[async], nlevels, pmf, varnames, geom,
+                                                Real(step), level_steps, ref_ratio);
+                    }
+                }
+            }
+            if (async) writer->wait();
+            ParallelDescriptor::Barrier();
+            t_run[async] = amrex::second() - t0;
+
+            if (async) writer->printStats();
+        }
+
+        amrex::Print() << "Run time with WriteMultiLevelPlotfile: " << t_run[0] << "\n"
+                       << "Run time with AsyncPlotfileWriter:     " << t_run[1] << "\n";
+
+        if (!last_plotfile[0].empty())
+        {
+            PlotFileData pf0(last_plotfile[0]);
+            PlotFileData pf1(last_plotfile[1]);
+            const Real tol = single_precision ? 1.e-6 : 0.0;
+            for (int lev = 0; lev < nlevels; ++lev) {
+                MultiFab a = pf0.get(lev);
+                MultiFab b = pf1.get(lev);
+                MultiFab::Subtract(b, a, 0, 0, ncomp, 0);
+                for (int n = 0; n < ncomp; ++n) {
+                    if (b.norm0(n) > tol*a.norm0(n)) {
+                        amrex::Abort("AsyncPlotfileWriter: plotfiles differ on level "
+                                     + std::to_string(lev));
+                    }
+                }
+            }
+            amrex::Print() << "Plotfiles agree\n";
+        }
+    }
+    amrex::Finalize();
+}
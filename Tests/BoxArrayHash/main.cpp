@@ -0,0 +1,164 @@
+#include <random>
+#include <unordered_set>
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+namespace {
+
+// For access to the communication metadata.
+class MetaMultiFab
+    : public MultiFab
+{
+public:
+    using MultiFab::MultiFab;
+    using MultiFab::getFB;
+    using MultiFab::getCPC;
+};
+
+}
+
+//
+// Time the BoxArray hash and the FillBoundary and ParallelCopy metadata
+// for a BoxArray with mixed box sizes: the domain is chopped into boxes of
+// max_grid_size, and a fine_fraction of them is chopped further into boxes
+// of min_grid_size.  With check = 1, intersections and complementIn are
+// compared with a brute force search for some boxes.
+//
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 128;
+        int max_grid_size = 32;
+        int min_grid_size = 4;
+        Real fine_fraction = 0.5;
+        int nghost = 1;
+        bool check = true;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("min_grid_size", min_grid_size);
+            pp.query("fine_fraction", fine_fraction);
+            pp.query("nghost", nghost);
+            pp.query("check", check);
+        }
+
+        Box domain(IntVect(0), IntVect(n_cell-1));
+        BoxArray cba(domain);
+        cba.maxSize(max_grid_size);
+
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<Real> dist(0.0, 1.0);
+        BoxList bl;
+        for (int i = 0; i < cba.size(); ++i) {
+            if (dist(gen) < fine_fraction) {
+                BoxList fbl(cba[i]);
+                fbl.maxSize(min_grid_size);
+                bl.join(fbl);
+            } else {
+                bl.push_back(cba[i]);
+            }
+        }
+        BoxArray ba(std::move(bl));
+
+        amrex::Print() << "Number of boxes: " << ba.size() << "\n";
+
+        Real t0 = amrex::second();
+        ba.intersects(ba[0]);  // builds the hash
+        Real t_hash = amrex::second() - t0;
+
+        t0 = amrex::second();
+        std::vector<std::pair<int,Box> > isects;
+        long nisects = 0;
+        for (int i = 0; i < ba.size(); ++i) {
+            ba.intersections(amrex::grow(ba[i],nghost), isects);
+            nisects += isects.size();
+        }
+        Real t_query = amrex::second() - t0;
+
+        DistributionMapping dm(ba);
+        MetaMultiFab mf(ba, dm, 1, nghost, MFInfo().SetAlloc(false));
+        MetaMultiFab cmf(cba, DistributionMapping(cba), 1, 0, MFInfo().SetAlloc(false));
+
+        t0 = amrex::second();
+        mf.getFB(IntVect(nghost), Periodicity::NonPeriodic());
+        Real t_fb = amrex::second() - t0;
+
+        t0 = amrex::second();
+        cmf.getCPC(IntVect(0), mf, IntVect(nghost), Periodicity::NonPeriodic());
+        Real t_cpc = amrex::second() - t0;
+
+        ParallelDescriptor::ReduceRealMax(t_fb);
+        ParallelDescriptor::ReduceRealMax(t_cpc);
+
+        amrex::Print() << "Hash build time:              " << t_hash << "\n"
+                       << "Intersections of all boxes:   " << t_query
+                       << " (" << nisects << " intersections)\n"
+                       << "FillBoundary metadata time:   " << t_fb << "\n"
+                       << "ParallelCopy metadata time:   " << t_cpc << "\n";
+
+        if (check)
+        {
+            std::uniform_int_distribution<int> pick(0, ba.size()-1);
+            for (int n = 0; n < 1000; ++n)
+            {
+                const Box& bx = amrex::grow(ba[pick(gen)], 3*nghost);
+                ba.intersections(bx, isects);
+                std::vector<std::pair<int,Box> > brute;
+                long npts = 0;
+                for (int i = 0; i < ba.size(); ++i) {
+                    const Box& isect = bx & ba[i];
+                    if (isect.ok()) {
+                        brute.push_back(std::make_pair(i,isect));
+                        npts += isect.numPts();
+                    }
+                }
+                std::sort(isects.begin(), isects.end(),
+                          [] (const std::pair<int,Box>& a, const std::pair<int,Box>& b)
+                          { return a.first < b.first; });
+                if (isects != brute) {
+                    amrex::Abort("intersections differ from brute force search");
+                }
+                // The boxes are disjoint.
+                long ncomp = 0;
+                for (const Box& b : ba.complementIn(bx)) {
+                    ncomp += b.numPts();
+                }
+                if (ncomp != bx.numPts() - npts) {
+                    amrex::Abort("complementIn differs from brute force search");
+                }
+            }
+            amrex::Print() << "Checked intersections and complementIn\n";
+
+            // removeOverlap adds the pieces of the boxes it cuts to the
+            // hash, where they must be found by the later queries.
+            BoxList obl;
+            obl.push_back(Box(IntVect(0), IntVect(15)));
+            obl.push_back(Box(IntVect(AMREX_D_DECL(14,14,14)), IntVect(AMREX_D_DECL(19,17,17))));
+            obl.push_back(Box(IntVect(AMREX_D_DECL(14,14,13)), IntVect(AMREX_D_DECL(19,17,16))));
+            obl.push_back(Box(IntVect(200), IntVect(203)));
+            std::unordered_set<IntVect,IntVect::shift_hasher> cells;
+            for (const Box& b : obl) {
+                for (IntVect iv = b.smallEnd(); iv <= b.bigEnd(); b.next(iv)) {
+                    cells.insert(iv);
+                }
+            }
+            BoxArray oba(std::move(obl));
+            oba.removeOverlap(false);
+            if (!oba.isDisjoint()) {
+                amrex::Abort("boxes overlap after removeOverlap");
+            }
+            if (oba.numPts() != static_cast<long>(cells.size())) {
+                amrex::Abort("removeOverlap changed the cells covered");
+            }
+            amrex::Print() << "Checked removeOverlap\n";
+        }
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,112 @@
+#include <cmath>
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+//
+// A dummy kernel whose cost per cell is stiff_factor times higher inside a
+// sphere, like chemistry in a flame.  The boxes are first distributed by
+// volume.  The per-box wall times measured by MFIter are then used to make
+// a new DistributionMapping, and the run is repeated on it.
+//
+
+namespace {
+
+Real advance (MultiFab& mf, const Box& domain, int nsteps, int work, int stiff_factor,
+              Vector<Real>* cost)
+{
+    const Real t0 = amrex::second();
+    const IntVect center = (domain.smallEnd() + domain.bigEnd()) / 2;
+    const Real r2 = Real(domain.length(0)*domain.length(0)) / 16.;
+
+    MFItInfo info;
+    info.EnableTiling().SetDynamic(true);
+    if (cost) info.SetCost(*cost);
+
+    for (int step = 0; step < nsteps; ++step) {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(mf,info); mfi.isValid(); ++mfi) {
+            const Box& bx = mfi.tilebox();
+            const Box& vbx = mfi.validbox();
+            const IntVect d = vbx.smallEnd() - center;
+            Real dist2 = 0.;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                dist2 += Real(d[idim])*d[idim];
+            }
+            const int niter = (dist2 < r2) ? work*stiff_factor : work;
+            auto const& a = mf.array(mfi);
+            amrex::ParallelFor(bx, [=] (int i, int j, int k) noexcept
+            {
+                Real x = a(i,j,k);
+                for (int n = 0; n < niter; ++n) {
+                    x = std::sqrt(x*x + 1.0) - 0.5*x;
+                }
+                a(i,j,k) = x;
+            });
+        }
+    }
+
+    Real t = amrex::second() - t0;
+    ParallelDescriptor::ReduceRealMax(t);
+    return t;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 128;
+        int max_grid_size = 16;
+        int nsteps = 5;
+        int work = 4;
+        int stiff_factor = 8;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("nsteps", nsteps);
+            pp.query("work", work);
+            pp.query("stiff_factor", stiff_factor);
+        }
+
+        Box domain(IntVect(0), IntVect(n_cell-1));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+
+        DistributionMapping dm(ba);
+        MultiFab mf(ba, dm, 1, 0);
+        mf.setVal(1.0);
+
+        Vector<Real> cost(ba.size(), 0.0);
+        const Real t_old = advance(mf, domain, nsteps, work, stiff_factor, &cost);
+
+        DistributionMapping newdm = DistributionMapping::makeBalanced(cost, ba, dm, sizeof(Real));
+
+        // Every process has only filled in its own boxes.
+        ParallelAllReduce::Sum(cost.data(), cost.size(), ParallelDescriptor::Communicator());
+        const Real eff_old = dm.efficiency(cost);
+        if (newdm == dm) {
+            amrex::Print() << "Kept the volume based DistributionMapping\n";
+        } else {
+            MultiFab tmp(ba, newdm, 1, 0);
+            tmp.ParallelCopy(mf);
+            mf = std::move(tmp);
+        }
+
+        std::fill(cost.begin(), cost.end(), 0.0);
+        const Real t_new = advance(mf, domain, nsteps, work, stiff_factor, &cost);
+        ParallelAllReduce::Sum(cost.data(), cost.size(), ParallelDescriptor::Communicator());
+        const Real eff_new = newdm.efficiency(cost);
+
+        amrex::Print() << "Volume weights: time " << t_old << ", efficiency " << eff_old << "\n"
+                       << "Measured costs: time " << t_new << ", efficiency " << eff_new << "\n";
+    }
+    amrex::Finalize();
+}
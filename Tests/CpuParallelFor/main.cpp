@@ -0,0 +1,170 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+//
+// Compare ParallelFor and ReduceOps threaded over the cells of each box
+// (amrex.omp_parallel_for) with the same kernels run on the tiles of a
+// tiled MFIter loop in an OpenMP parallel region.
+//
+
+namespace {
+
+void laplacian (MultiFab& lap, const MultiFab& phi, bool tiling)
+{
+#ifdef _OPENMP
+#pragma omp parallel if (tiling)
+#endif
+    for (MFIter mfi(lap, tiling); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        auto const& l = lap.array(mfi);
+        auto const& p = phi.const_array(mfi);
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            l(i,j,k) = p(i-1,j,k) + p(i+1,j,k) + p(i,j-1,k) + p(i,j+1,k)
+                +      p(i,j,k-1) + p(i,j,k+1) - 6.0*p(i,j,k);
+        });
+    }
+}
+
+GpuTuple<Real,Real> sumMax (const MultiFab& mf, bool tiling)
+{
+    ReduceOps<ReduceOpSum,ReduceOpMax> reduce_op;
+    ReduceData<Real,Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+#ifdef _OPENMP
+#pragma omp parallel if (tiling)
+#endif
+    for (MFIter mfi(mf, tiling); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        auto const& a = mf.const_array(mfi);
+        reduce_op.eval(bx, reduce_data,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+        {
+            return {a(i,j,k), std::abs(a(i,j,k))};
+        });
+    }
+    return reduce_data.value();
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 128;
+        int max_grid_size = 64;
+        int nrepeat = 20;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("nrepeat", nrepeat);
+        }
+
+        BoxArray ba(Box(IntVect(0), IntVect(n_cell-1)));
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        MultiFab phi(ba, dm, 1, 1);
+        MultiFab lap0(ba, dm, 1, 0);
+        MultiFab lap1(ba, dm, 1, 0);
+        for (MFIter mfi(phi); mfi.isValid(); ++mfi)
+        {
+            auto const& p = phi.array(mfi);
+            amrex::LoopOnCpu(mfi.fabbox(), [=] (int i, int j, int k) noexcept
+            {
+                p(i,j,k) = std::sin(0.1*i) * std::cos(0.07*j) + 1.e-3*k;
+            });
+        }
+
+        GpuTuple<Real,Real> r0, r1;
+
+        // Tiled MFIter in an OpenMP parallel region.
+        Gpu::setOmpLaunchRegion(false);
+        laplacian(lap0, phi, true);
+        ParallelDescriptor::Barrier();
+        Real t0 = amrex::second();
+        for (int n = 0; n < nrepeat; ++n) {
+            laplacian(lap0, phi, true);
+        }
+        Real t_tiled = amrex::second() - t0;
+        t0 = amrex::second();
+        for (int n = 0; n < nrepeat; ++n) {
+            r0 = sumMax(lap0, true);
+        }
+        Real t_tiled_reduce = amrex::second() - t0;
+
+        // Serial loops over boxes, each kernel threaded over its cells.
+        Gpu::OmpLaunchSafeGuard lsg(true);
+        laplacian(lap1, phi, false);
+        ParallelDescriptor::Barrier();
+        t0 = amrex::second();
+        for (int n = 0; n < nrepeat; ++n) {
+            laplacian(lap1, phi, false);
+        }
+        Real t_threaded = amrex::second() - t0;
+        t0 = amrex::second();
+        for (int n = 0; n < nrepeat; ++n) {
+            r1 = sumMax(lap1, false);
+        }
+        Real t_threaded_reduce = amrex::second() - t0;
+
+        ParallelDescriptor::ReduceRealMax(t_tiled);
+        ParallelDescriptor::ReduceRealMax(t_tiled_reduce);
+        ParallelDescriptor::ReduceRealMax(t_threaded);
+        ParallelDescriptor::ReduceRealMax(t_threaded_reduce);
+
+        amrex::Print() << "ParallelFor: tiled MFIter " << t_tiled/nrepeat
+                       << ", threaded ParallelFor " << t_threaded/nrepeat << " seconds\n"
+                       << "ReduceOps:   tiled MFIter " << t_tiled_reduce/nrepeat
+                       << ", threaded ReduceOps " << t_threaded_reduce/nrepeat << " seconds\n";
+
+        MultiFab::Subtract(lap1, lap0, 0, 0, 1, 0);
+        const Real diff = lap1.norm0();
+        const Real dsum = std::abs(amrex::get<0>(r0) - amrex::get<0>(r1));
+        amrex::Print() << "Max difference: ParallelFor " << diff
+                       << ", sum " << dsum
+                       << ", max " << std::abs(amrex::get<1>(r0) - amrex::get<1>(r1)) << "\n";
+        if (diff != 0.0 || amrex::get<1>(r0) != amrex::get<1>(r1) ||
+            dsum > 1.e-10 * std::abs(amrex::get<0>(r0)) + 1.e-10)
+        {
+            amrex::Abort("The threaded kernels give different results");
+        }
+        amrex::Print() << "The threaded kernels give the same results\n";
+
+        // The component index is passed to the kernel.
+        {
+            MultiFab mf2(ba, dm, 2, 0);
+            mf2.setVal(1.0, 0, 1);
+            mf2.setVal(2.0, 1, 1);
+            ReduceOps<ReduceOpSum> reduce_op;
+            ReduceData<Real> reduce_data(reduce_op);
+            using ReduceTuple = typename decltype(reduce_data)::Type;
+            for (MFIter mfi(mf2); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.validbox();
+                auto const& a = mf2.const_array(mfi);
+                reduce_op.eval(bx, 2, reduce_data,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) -> ReduceTuple
+                {
+                    return {a(i,j,k,n)*(n+1)};
+                });
+            }
+            Real s = amrex::get<0>(reduce_data.value());
+            ParallelDescriptor::ReduceRealSum(s);
+            if (s != 5.0*ba.numPts()) {
+                amrex::Abort("ReduceOps over components gives a wrong sum");
+            }
+            amrex::Print() << "ReduceOps over components gives the right sum\n";
+        }
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,189 @@
+#include <cmath>
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_TagBox.H>
+#include <AMReX_Cluster.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+//
+// Compare clustering all the tags gathered to every process with
+// clustering the tags of each process and merging the boxes.
+//
+
+namespace {
+
+void report (const std::string& name, const BoxList& bl, long ntags, Real t)
+{
+    long npts = 0;
+    for (const Box& b : bl) {
+        npts += b.numPts();
+    }
+    amrex::Print() << name << ": " << bl.size() << " boxes, " << npts << " cells, "
+                   << "efficiency " << Real(ntags)/npts << ", time " << t << "\n";
+}
+
+// Are all the local tags covered exactly once?
+bool covers (const BoxList& bl, const Vector<IntVect>& tagvec)
+{
+    BoxArray ba(bl);
+    std::vector< std::pair<int,Box> > isects;
+    bool ok = true;
+    for (const IntVect& iv : tagvec) {
+        ba.intersections(Box(iv,iv), isects);
+        ok = ok && isects.size() == 1;
+    }
+    ParallelDescriptor::ReduceBoolAnd(ok);
+    return ok;
+}
+
+// Does every box contain tags, at least grid_eff of its cells?
+bool efficient (const BoxList& bl, const Vector<IntVect>& tagvec, Real grid_eff)
+{
+    BoxArray ba(bl);
+    Vector<long> ntags(ba.size(), 0);
+    std::vector< std::pair<int,Box> > isects;
+    for (const IntVect& iv : tagvec) {
+        ba.intersections(Box(iv,iv), isects);
+        for (const auto& is : isects) {
+            ++ntags[is.first];
+        }
+    }
+    ParallelDescriptor::ReduceLongSum(ntags.data(), ntags.size());
+    bool ok = true;
+    for (int i = 0; i < ba.size(); ++i) {
+        ok = ok && ntags[i] > 0 && Real(ntags[i]) >= grid_eff*Real(ba[i].numPts());
+    }
+    return ok;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 256;
+        int max_grid_size = 32;
+        Real radius = 0.35;
+        Real thickness = 2.;
+        Real grid_eff = 0.7;
+        int check = 1;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("radius", radius);
+            pp.query("thickness", thickness);
+            pp.query("grid_eff", grid_eff);
+            pp.query("check", check);
+        }
+
+        Box domain(IntVect(0), IntVect(n_cell-1));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        TagBoxArray tags(ba, dm);
+        tags.setVal(TagBox::CLEAR);
+        const Real r = radius*n_cell;
+        const Real c = 0.5*n_cell;
+        for (MFIter mfi(tags); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.validbox();
+            TagBox& tb = tags[mfi];
+            for (BoxIterator bi(bx); bi.ok(); ++bi)
+            {
+                const IntVect& iv = bi();
+                Real d2 = 0.;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    d2 += (iv[idim]+0.5-c)*(iv[idim]+0.5-c);
+                }
+                if (std::abs(std::sqrt(d2)-r) < 0.5*thickness) {
+                    tb(iv) = TagBox::SET;
+                }
+            }
+        }
+
+        const long ntags = tags.numTags();
+        amrex::Print() << "Number of tags: " << ntags << "\n";
+
+        BoxList bl_global;
+        {
+            ParallelDescriptor::Barrier();
+            Real t0 = amrex::second();
+            Vector<IntVect> tagvec;
+            tags.collate(tagvec);
+            if (tagvec.size() > 0) {
+                ClusterList clist(&tagvec[0], tagvec.size());
+                clist.chop(grid_eff);
+                clist.boxList(bl_global);
+            }
+            Real t = amrex::second() - t0;
+            ParallelDescriptor::ReduceRealMax(t);
+            report("Gathered tags  ", bl_global, ntags, t);
+        }
+
+        BoxList bl_dist;
+        Vector<IntVect> local_tags;
+        {
+            ParallelDescriptor::Barrier();
+            Real t0 = amrex::second();
+            tags.localCollate(local_tags);
+            Vector<IntVect> tagvec = local_tags;
+            if (tagvec.size() > 0) {
+                ClusterList clist(&tagvec[0], tagvec.size());
+                clist.chop(grid_eff);
+                clist.boxList(bl_dist);
+            }
+            MergeDistributedClusters(bl_dist, tagvec, grid_eff);
+            Real t = amrex::second() - t0;
+            ParallelDescriptor::ReduceRealMax(t);
+            report("Distributed    ", bl_dist, ntags, t);
+        }
+
+        if (check)
+        {
+            if (!covers(bl_global, local_tags)) {
+                amrex::Abort("Gathered clustering does not cover every tag exactly once");
+            }
+            if (!covers(bl_dist, local_tags)) {
+                amrex::Abort("Distributed clustering does not cover every tag exactly once");
+            }
+
+            if (!efficient(bl_dist, local_tags, grid_eff)) {
+                amrex::Abort("Distributed clustering has a box below grid_eff");
+            }
+
+            // Every process must have the same boxes.
+            Vector<Box> bxs(bl_dist.begin(), bl_dist.end());
+            int n = bxs.size();
+            ParallelDescriptor::Bcast(&n, 1, ParallelDescriptor::IOProcessorNumber());
+            bool same = (n == static_cast<int>(bxs.size()));
+            if (same) {
+                const int nints = n*3*AMREX_SPACEDIM;
+                Vector<int> a;
+                a.reserve(nints);
+                for (const Box& b : bxs) {
+                    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                        a.push_back(b.smallEnd(idim));
+                        a.push_back(b.bigEnd(idim));
+                        a.push_back(b.type(idim));
+                    }
+                }
+                Vector<int> b = a;
+                ParallelDescriptor::Bcast(b.data(), nints, ParallelDescriptor::IOProcessorNumber());
+                same = (a == b);
+            }
+            ParallelDescriptor::ReduceBoolAnd(same);
+            if (!same) {
+                amrex::Abort("Distributed clustering differs between processes");
+            }
+            amrex::Print() << "Both clusterings cover every tag exactly once and the distributed\n"
+                           << "boxes all have tags in at least grid_eff of their cells\n";
+        }
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,181 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_EB2.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+//
+// Build an EB2::IndexSpace, write it out, read it back and check that
+// every level gives the same data as the IndexSpace built from the
+// implicit function.
+//
+
+namespace {
+
+Real maxDiff (const MultiFab& a, const MultiFab& b)
+{
+    MultiFab d(a.boxArray(), a.DistributionMap(), a.nComp(), a.nGrow());
+    MultiFab::Copy(d, a, 0, 0, a.nComp(), a.nGrow());
+    MultiFab::Subtract(d, b, 0, 0, a.nComp(), a.nGrow());
+    Real r = 0.;
+    for (int n = 0; n < a.nComp(); ++n) {
+        r = std::max(r, d.norm0(n, a.nGrow()));
+    }
+    return r;
+}
+
+long numDiffFlags (const FabArray<EBCellFlagFab>& a, const FabArray<EBCellFlagFab>& b)
+{
+    long n = 0;
+    for (MFIter mfi(a); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.fabbox();
+        auto const& fa = a.const_array(mfi);
+        auto const& fb = b.const_array(mfi);
+        if (a[mfi].getType() != b[mfi].getType()) ++n;
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+        {
+            if (fa(i,j,k).getValue() != fb(i,j,k).getValue()) ++n;
+        });
+    }
+    ParallelDescriptor::ReduceLongSum(n);
+    return n;
+}
+
+Real compare (const EB2::Level& lev0, const EB2::Level& lev1, const Geometry& geom,
+              const BoxArray& ba, const DistributionMapping& dm, long& nflags)
+{
+    const int ng = 2;
+
+    FabArray<EBCellFlagFab> flag0(ba, dm, 1, ng), flag1(ba, dm, 1, ng);
+    lev0.fillEBCellFlag(flag0, geom);
+    lev1.fillEBCellFlag(flag1, geom);
+    nflags = numDiffFlags(flag0, flag1);
+
+    Real r = 0.;
+
+    MultiFab s0(ba, dm, 1, ng), s1(ba, dm, 1, ng);
+    lev0.fillVolFrac(s0, geom);
+    lev1.fillVolFrac(s1, geom);
+    r = std::max(r, maxDiff(s0,s1));
+    lev0.fillBndryArea(s0, geom);
+    lev1.fillBndryArea(s1, geom);
+    r = std::max(r, maxDiff(s0,s1));
+
+    MultiFab v0(ba, dm, AMREX_SPACEDIM, ng), v1(ba, dm, AMREX_SPACEDIM, ng);
+    lev0.fillCentroid(v0, geom);
+    lev1.fillCentroid(v1, geom);
+    r = std::max(r, maxDiff(v0,v1));
+    lev0.fillBndryCent(v0, geom);
+    lev1.fillBndryCent(v1, geom);
+    r = std::max(r, maxDiff(v0,v1));
+    lev0.fillBndryNorm(v0, geom);
+    lev1.fillBndryNorm(v1, geom);
+    r = std::max(r, maxDiff(v0,v1));
+
+    Array<MultiFab,AMREX_SPACEDIM> a0, a1, f0, f1;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        const BoxArray& fba = amrex::convert(ba, IntVect::TheDimensionVector(idim));
+        a0[idim].define(fba, dm, 1, ng);
+        a1[idim].define(fba, dm, 1, ng);
+        f0[idim].define(fba, dm, AMREX_SPACEDIM-1, ng);
+        f1[idim].define(fba, dm, AMREX_SPACEDIM-1, ng);
+    }
+    lev0.fillAreaFrac(amrex::GetArrOfPtrs(a0), geom);
+    lev1.fillAreaFrac(amrex::GetArrOfPtrs(a1), geom);
+    lev0.fillFaceCent(amrex::GetArrOfPtrs(f0), geom);
+    lev1.fillFaceCent(amrex::GetArrOfPtrs(f1), geom);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        r = std::max(r, maxDiff(a0[idim],a1[idim]));
+        r = std::max(r, maxDiff(f0[idim],f1[idim]));
+    }
+
+    const BoxArray& nba = amrex::convert(ba, IntVect::TheNodeVector());
+    MultiFab l0(nba, dm, 1, 0), l1(nba, dm, 1, 0);
+    lev0.fillLevelSet(l0, geom);
+    lev1.fillLevelSet(l1, geom);
+    r = std::max(r, maxDiff(l0,l1));
+
+    return r;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 128;
+        int max_grid_size = 32;
+        int max_coarsening_level = 10;
+        std::string chkpt_file = "eb2_chkpt";
+        int write_chkpt = 1;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("max_coarsening_level", max_coarsening_level);
+            pp.query("chkpt_file", chkpt_file);
+            pp.query("write_chkpt", write_chkpt);
+        }
+
+        Geometry geom;
+        {
+            RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+            Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+            Box domain(IntVect(0), IntVect(n_cell-1));
+            geom.define(domain, rb, CoordSys::cartesian, is_periodic);
+        }
+
+        ParallelDescriptor::Barrier();
+        Real t0 = amrex::second();
+        EB2::Build(geom, 0, max_coarsening_level);
+        Real t_build = amrex::second() - t0;
+        const EB2::IndexSpace* built = &EB2::IndexSpace::top();
+
+        if (write_chkpt) {
+            t0 = amrex::second();
+            built->write(chkpt_file);
+            Real t_write = amrex::second() - t0;
+            amrex::Print() << "Wrote " << chkpt_file << " in " << t_write << " seconds\n";
+        }
+
+        ParallelDescriptor::Barrier();
+        t0 = amrex::second();
+        EB2::BuildFromChkptFile(chkpt_file, geom, 0, max_coarsening_level);
+        Real t_load = amrex::second() - t0;
+        const EB2::IndexSpace* loaded = &EB2::IndexSpace::top();
+
+        amrex::Print() << "Time to build from the implicit function: " << t_build << "\n"
+                       << "Time to read from " << chkpt_file << ": " << t_load << "\n";
+
+        const int nlevs = EB2::maxCoarseningLevel(built, geom);
+        if (EB2::maxCoarseningLevel(loaded, geom) != nlevs) {
+            amrex::Abort("The number of coarsening levels differs");
+        }
+
+        Geometry cgeom = geom;
+        for (int ilev = 0; ilev <= nlevs; ++ilev)
+        {
+            // Use grids unrelated to those the levels are stored on.
+            BoxArray ba(cgeom.Domain());
+            ba.maxSize(std::max(max_grid_size/2, 4));
+            DistributionMapping dm(ba);
+
+            long nflags;
+            Real r = compare(built->getLevel(cgeom), loaded->getLevel(cgeom),
+                             cgeom, ba, dm, nflags);
+            amrex::Print() << "Level " << ilev << " " << cgeom.Domain()
+                           << ": " << nflags << " flags differ, max difference " << r << "\n";
+            if (nflags != 0 || r != 0.) {
+                amrex::Abort("The IndexSpace read back differs");
+            }
+
+            cgeom = amrex::coarsen(cgeom, 2);
+        }
+        amrex::Print() << "The IndexSpace read back is identical\n";
+    }
+    amrex::Finalize();
+}
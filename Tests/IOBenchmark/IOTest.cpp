@@ -252,6 +252,9 @@ void TestWriteNFiles(int nfiles, int maxgrid, int ncomps, int nboxes,
     case VisMF::Header::NoFabHeaderFAMinMax_v1:
       mfName = "TestMFNoFabHeaderFAMinMax";
     break;
+    case VisMF::Header::Compressed_v1:
+      mfName = "TestMFCompressed";
+    break;
     default:
       amrex::Abort("**** Error in TestWriteNFiles:  bad version.");
   }
@@ -323,6 +326,33 @@ void TestWriteNFiles(int nfiles, int maxgrid, int ncomps, int nboxes,
     cout << "------------------------------------------" << endl;
   }
 
+  if(whichVersion == VisMF::Header::Compressed_v1) {
+    // ---- report against the uncompressed size and check the data
+    long rawBytes(0);
+    Real maxError(0.0), maxValue(0.0);
+    for(int nmf(0); nmf < nMultiFabs; ++nmf) {
+      rawBytes += multifabs[nmf]->boxArray().numPts() * ncomps * sizeof(Real);
+      MultiFab mfRead(bArray, dmap, ncomps, 0);
+      VisMF::Read(mfRead, mfNames[nmf]);
+      MultiFab::Subtract(mfRead, *multifabs[nmf], 0, 0, ncomps, 0);
+      for(int n(0); n < ncomps; ++n) {
+        maxError = std::max(maxError, mfRead.norm0(n));
+        maxValue = std::max(maxValue, multifabs[nmf]->norm0(n));
+      }
+    }
+    Real rawMegabytes((static_cast<Real> (rawBytes)) / bytesPerMB);
+    if(ParallelDescriptor::IOProcessor()) {
+      cout << "  Codec                 = " << VisMF::GetCodec()
+           << " " << VisMF::GetCodecParam() << endl;
+      cout << "  Uncompressed megabytes = " << rawMegabytes << endl;
+      cout << "  Compression ratio     = " << rawMegabytes / megabytes << endl;
+      cout << "  Write:  uncompressed Megabytes/sec = " << rawMegabytes/wallTimeMax << endl;
+      cout << "  Max read back error   = " << maxError
+           << "  (max abs value = " << maxValue << ")" << endl;
+      cout << "------------------------------------------" << endl;
+    }
+  }
+
   for(int nmf(0); nmf < nMultiFabs; ++nmf) {
     delete multifabs[nmf];
   }
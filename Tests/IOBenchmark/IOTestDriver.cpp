@@ -71,6 +71,7 @@ static void PrintUsage(const char *progName) {
     cout << "   [pifstreams        = tf       ]" << '\n';
     cout << "   [usedss            = tf       ]" << '\n';
     cout << "   [usesyncreads      = tf       ]" << '\n';
+    cout << "   [usemmap           = tf       ]" << '\n';
     cout << "   [nmultifabs        = nmf      ]" << '\n';
     cout << "   [dirname           = dirname  ]" << '\n';
     cout << '\n';
@@ -102,7 +103,7 @@ int main(int argc, char *argv[]) {
   bool useSingleRead(false), useSingleWrite(false);
   bool checkFPositions(false), pIFStreams(false);
   bool checkmf(false);
-  bool useDSS(false), useSyncReads(false);
+  bool useDSS(false), useSyncReads(false), useMmap(false);
   Vector<int> testWriteNFilesVersions;
   Vector<std::string> readFANames;
   int nReadStreams(1), nMultiFabs(1);
@@ -141,6 +142,7 @@ int main(int argc, char *argv[]) {
   pp.query("pifstreams", pIFStreams);
   pp.query("usedss", useDSS);
   pp.query("usesyncreads", useSyncReads);
+  pp.query("usemmap", useMmap);
   pp.query("nmultifabs", nMultiFabs);
   nMultiFabs = std::max(1, std::min(nMultiFabs, 32));
 
@@ -197,6 +199,7 @@ int main(int argc, char *argv[]) {
     cout << "pifstreams        = " << pIFStreams << '\n';
     cout << "usedss            = " << useDSS << '\n';
     cout << "usesyncreads      = " << useSyncReads << '\n';
+    cout << "usemmap           = " << useMmap << '\n';
     cout << "nmultifabs        = " << nMultiFabs << '\n';
     cout << "dirName           = " << dirName << '\n';
 
@@ -331,6 +334,7 @@ int main(int argc, char *argv[]) {
   VisMF::SetUseSingleWrite(useSingleWrite);
   VisMF::SetCheckFilePositions(checkFPositions);
   VisMF::SetUsePersistentIFStreams(pIFStreams);
+  VisMF::SetUseMmap(useMmap);
 
   if(nfileitertest) {
     for(int itimes(0); itimes < ntimes; ++itimes) {
@@ -427,6 +431,9 @@ int main(int argc, char *argv[]) {
       case 4:
         hVersion = VisMF::Header::NoFabHeaderFAMinMax_v1;
       break;
+      case 5:
+        hVersion = VisMF::Header::Compressed_v1;
+      break;
       default:
         amrex::Abort("**** Error:  bad hVersion.");
       }
@@ -0,0 +1,277 @@
+#include <cmath>
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Amr.H>
+#include <AMReX_AmrLevel.H>
+#include <AMReX_LevelBld.H>
+#include <AMReX_TagBox.H>
+#include <AMReX_Interpolater.H>
+#include <AMReX_PROB_AMR_F.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+//
+// Regrid with amr.incremental_regrid = 1, with some of the fine boxes
+// unchanged.  The unchanged boxes must keep their process and their data,
+// and the new boxes must be filled as a full FillPatch fills them.
+//
+
+namespace {
+
+enum StateType { Phi_Type = 0 };
+
+Real radius = 0.12;
+// The centers of the two balls of tags.
+Array<Real,AMREX_SPACEDIM> center0 {AMREX_D_DECL(0.25,0.25,0.25)};
+Array<Real,AMREX_SPACEDIM> center1 {AMREX_D_DECL(0.7,0.7,0.7)};
+
+// Counted by TestLevel::init(old) over all the regrids.
+long nkept = 0;
+long nfilled = 0;
+long nwrong_owner = 0;
+long nwrong_data = 0;
+
+Real phi0 (const Real* x)
+{
+    Real r = 1.0;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        r *= std::sin(2.*M_PI*x[idim] + idim);
+    }
+    return r;
+}
+
+bool inBall (const Real* x, const Array<Real,AMREX_SPACEDIM>& c)
+{
+    Real d2 = 0.;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        d2 += (x[idim]-c[idim])*(x[idim]-c[idim]);
+    }
+    return d2 < radius*radius;
+}
+
+void nullfill (Box const&, FArrayBox&, const int, const int, Geometry const&, const Real,
+               const Vector<BCRec>&, const int, const int)
+{}
+
+class TestLevel
+    : public AmrLevel
+{
+public:
+
+    TestLevel () noexcept {}
+
+    TestLevel (Amr& papa, int lev, const Geometry& level_geom, const BoxArray& bl,
+               const DistributionMapping& dm, Real time)
+        : AmrLevel(papa, lev, level_geom, bl, dm, time)
+        {}
+
+    static void variableSetUp ()
+    {
+        desc_lst.addDescriptor(Phi_Type, IndexType::TheCellType(), StateDescriptor::Point,
+                               0, 1, &cell_cons_interp);
+        int lo_bc[AMREX_SPACEDIM], hi_bc[AMREX_SPACEDIM];
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            lo_bc[idim] = hi_bc[idim] = BCType::int_dir;
+        }
+        desc_lst.setComponent(Phi_Type, 0, "phi", BCRec(lo_bc,hi_bc),
+                              StateDescriptor::BndryFunc(nullfill));
+    }
+
+    static void variableCleanUp () { desc_lst.clear(); }
+
+    virtual void computeInitialDt (int finest_level, int, Vector<int>& n_cycle,
+                                   const Vector<IntVect>&, Vector<Real>& dt_level, Real) override
+    {
+        for (int i = 0; i <= finest_level; ++i) {
+            dt_level[i] = 1.0;
+            n_cycle[i] = 1;
+        }
+    }
+
+    virtual void computeNewDt (int finest_level, int sub_cycle, Vector<int>& n_cycle,
+                               const Vector<IntVect>& ref_ratio, Vector<Real>&,
+                               Vector<Real>& dt_level, Real stop_time, int) override
+    {
+        computeInitialDt(finest_level, sub_cycle, n_cycle, ref_ratio, dt_level, stop_time);
+    }
+
+    virtual Real advance (Real, Real dt, int, int) override { return dt; }
+    virtual void post_timestep (int) override {}
+    virtual void post_regrid (int, int) override {}
+    virtual void post_init (Real) override {}
+
+    virtual void initData () override
+    {
+        MultiFab& S_new = get_new_data(Phi_Type);
+        const auto problo = geom.ProbLoArray();
+        const auto dx = geom.CellSizeArray();
+        for (MFIter mfi(S_new); mfi.isValid(); ++mfi)
+        {
+            const auto& phi = S_new.array(mfi);
+            amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+            {
+                const IntVect iv(AMREX_D_DECL(i,j,k));
+                Real x[AMREX_SPACEDIM];
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    x[idim] = problo[idim] + (iv[idim]+0.5)*dx[idim];
+                }
+                // A fine level that differs from the interpolated coarse data.
+                phi(i,j,k) = phi0(x) + level*0.1*x[0];
+            });
+        }
+    }
+
+    virtual void init (AmrLevel& old) override
+    {
+        const Real cur_time = old.get_state_data(Phi_Type).curTime();
+        const Real prev_time = old.get_state_data(Phi_Type).prevTime();
+        setTimeLevel(cur_time, cur_time-prev_time, parent->dtLevel(level));
+
+        MultiFab& S_new = get_new_data(Phi_Type);
+        FillPatch(old, S_new, 0, cur_time, Phi_Type, 0, 1);
+
+        // What a full FillPatch gives.
+        MultiFab ref(grids, dmap, 1, 0);
+        {
+            FillPatchIterator fpi(old, ref, 0, cur_time, Phi_Type, 0, 1);
+            MultiFab::Copy(ref, fpi.get_mf(), 0, 0, 1, 0);
+        }
+
+        const MultiFab& S_old = old.get_new_data(Phi_Type);
+        const Vector<int> old_index = amrex::findIdenticalBoxes(grids, old.boxArray());
+        for (int i = 0, N = grids.size(); i < N; ++i) {
+            const int j = old_index[i];
+            if (j >= 0) {
+                ++nkept;
+                if (dmap[i] != old.DistributionMap()[j]) ++nwrong_owner;
+            } else {
+                ++nfilled;
+            }
+        }
+
+        for (MFIter mfi(S_new); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.validbox();
+            // A kept box must be a copy of the old one, if that is here.
+            const int j = old_index[mfi.index()];
+            const bool local = j >= 0 && S_old.DistributionMap()[j] == ParallelDescriptor::MyProc();
+            const FArrayBox& expected = local ? S_old[j] : ref[mfi];
+            const auto& a = S_new.const_array(mfi);
+            const auto& b = expected.const_array();
+            amrex::LoopOnCpu(bx, [&] (int i, int jj, int k) noexcept
+            {
+                if (a(i,jj,k) != b(i,jj,k)) ++nwrong_data;
+            });
+        }
+    }
+
+    virtual void init () override
+    {
+        const Real cur_time = parent->getLevel(level-1).get_state_data(Phi_Type).curTime();
+        const Real prev_time = parent->getLevel(level-1).get_state_data(Phi_Type).prevTime();
+        setTimeLevel(cur_time, cur_time-prev_time, parent->dtLevel(level));
+        FillCoarsePatch(get_new_data(Phi_Type), 0, cur_time, Phi_Type, 0, 1);
+    }
+
+    virtual void errorEst (TagBoxArray& tags, int, int tagval, Real, int, int) override
+    {
+        const auto problo = geom.ProbLoArray();
+        const auto dx = geom.CellSizeArray();
+        for (MFIter mfi(tags); mfi.isValid(); ++mfi)
+        {
+            TagBox& tb = tags[mfi];
+            amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+            {
+                const IntVect iv(AMREX_D_DECL(i,j,k));
+                Real x[AMREX_SPACEDIM];
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    x[idim] = problo[idim] + (iv[idim]+0.5)*dx[idim];
+                }
+                if (inBall(x,center0) || inBall(x,center1)) {
+                    tb(iv) = tagval;
+                }
+            });
+        }
+    }
+};
+
+class TestLevelBld
+    : public LevelBld
+{
+    virtual void variableSetUp () override { TestLevel::variableSetUp(); }
+    virtual void variableCleanUp () override { TestLevel::variableCleanUp(); }
+    virtual AmrLevel* operator() () override { return new TestLevel; }
+    virtual AmrLevel* operator() (Amr& papa, int lev, const Geometry& level_geom,
+                                  const BoxArray& ba, const DistributionMapping& dm,
+                                  Real time) override
+    {
+        return new TestLevel(papa, lev, level_geom, ba, dm, time);
+    }
+};
+
+TestLevelBld test_bld;
+
+class TestAmr
+    : public Amr
+{
+public:
+    using Amr::regrid;
+};
+
+}
+
+// Amr calls this, and there is no probin file to read.
+extern "C"
+void amrex_probinit (const int*, const int*, const int*, const amrex_real*, const amrex_real*)
+{}
+
+LevelBld*
+getLevelBld ()
+{
+    return &test_bld;
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int num_regrids = 3;
+        Real shift = 0.05;
+        {
+            ParmParse pp;
+            pp.query("radius", radius);
+            pp.query("num_regrids", num_regrids);
+            pp.query("shift", shift);
+        }
+
+        TestAmr amr;
+        amr.init(0.0, 1.0);
+
+        for (int n = 0; n < num_regrids; ++n) {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                center1[idim] -= shift;
+            }
+            amr.regrid(0, 0.0);
+        }
+
+        amrex::Print() << "Fine boxes kept " << nkept << ", filled " << nfilled
+                       << ", kept on another process " << nwrong_owner
+                       << ", cells that differ " << nwrong_data << "\n";
+
+        if (nkept == 0 || nfilled == 0) {
+            amrex::Abort("The regrids should keep some boxes and change others");
+        }
+        if (nwrong_owner > 0) {
+            amrex::Abort("A box that is kept has moved to another process");
+        }
+        ParallelDescriptor::ReduceLongSum(nwrong_data);
+        if (nwrong_data > 0) {
+            amrex::Abort("Incremental regridding gives different data");
+        }
+        amrex::Print() << "The kept boxes keep their process and data, and the others\n"
+                       << "are filled as a full FillPatch fills them\n";
+    }
+    amrex::Finalize();
+}
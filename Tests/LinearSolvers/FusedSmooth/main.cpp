@@ -0,0 +1,133 @@
+#include <cmath>
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_MLABecLaplacian.H>
+#include <AMReX_MLMG.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+//
+// The fused red-black smoother of MLABecLaplacian must give the same
+// result as the two separate sweeps, to the last bit.  Do a fixed number
+// of V-cycles with each and compare the solutions.
+//
+
+namespace {
+
+MultiFab solve (const Geometry& geom, const BoxArray& ba, const DistributionMapping& dm,
+                const MultiFab& rhs, const MultiFab& acoef,
+                const Array<MultiFab,AMREX_SPACEDIM>& bcoef,
+                LinOpBCType bc, int maxorder, int num_iter, bool fused)
+{
+    MLABecLaplacian mlabec({geom}, {ba}, {dm});
+    mlabec.setMaxOrder(maxorder);
+    mlabec.setFusedSmooth(fused);
+    mlabec.setDomainBC({AMREX_D_DECL(bc,bc,bc)}, {AMREX_D_DECL(bc,bc,bc)});
+
+    MultiFab sol(ba, dm, 1, 1);
+    sol.setVal(0.0);
+    mlabec.setLevelBC(0, &sol);
+
+    mlabec.setScalars(1.e-3, 1.0);
+    mlabec.setACoeffs(0, acoef);
+    mlabec.setBCoeffs(0, amrex::GetArrOfConstPtrs(bcoef));
+
+    MLMG mlmg(mlabec);
+    mlmg.setMaxIter(num_iter);
+    mlmg.setFixedIter(num_iter);
+    mlmg.setBottomSolver(MLMG::BottomSolver::smoother);
+    mlmg.setVerbose(0);
+    mlmg.solve({&sol}, {&rhs}, 1.e-30, 0.0);
+    return sol;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 64;
+        int max_grid_size = 32;
+        int num_iter = 4;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("num_iter", num_iter);
+        }
+
+        RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+        Geometry geom(Box(IntVect(0), IntVect(n_cell-1)), rb, CoordSys::cartesian, is_periodic);
+        Geometry geom_np(Box(IntVect(0), IntVect(n_cell-1)), rb, CoordSys::cartesian,
+                         Array<int,AMREX_SPACEDIM>{AMREX_D_DECL(0,0,0)});
+
+        BoxArray ba(geom.Domain());
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        MultiFab rhs(ba, dm, 1, 0);
+        MultiFab acoef(ba, dm, 1, 0);
+        Array<MultiFab,AMREX_SPACEDIM> bcoef;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            bcoef[idim].define(amrex::convert(ba,IntVect::TheDimensionVector(idim)), dm, 1, 0);
+        }
+
+        const auto dx = geom.CellSizeArray();
+        for (MFIter mfi(rhs); mfi.isValid(); ++mfi)
+        {
+            const auto& r = rhs.array(mfi);
+            const auto& a = acoef.array(mfi);
+            amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+            {
+                const Real x = (i+0.5)*dx[0];
+                const Real y = (AMREX_SPACEDIM > 1) ? (j+0.5)*dx[1] : 0.;
+                const Real z = (AMREX_SPACEDIM > 2) ? (k+0.5)*dx[2] : 0.;
+                r(i,j,k) = std::sin(6.*x+1.) * std::cos(4.*y-2.) * std::sin(2.*z+3.);
+                a(i,j,k) = 1. + x*y + z;
+            });
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+            {
+                const auto& b = bcoef[idim].array(mfi);
+                amrex::LoopOnCpu(amrex::surroundingNodes(mfi.validbox(),idim),
+                [&] (int i, int j, int k) noexcept
+                {
+                    const Real x = i*dx[0];
+                    const Real y = (AMREX_SPACEDIM > 1) ? j*dx[1] : 0.;
+                    const Real z = (AMREX_SPACEDIM > 2) ? k*dx[2] : 0.;
+                    b(i,j,k) = 1. + 0.5*std::sin(3.*x+2.*y+z+idim);
+                });
+            }
+        }
+        // Zero mean, so that the periodic problem is solvable.
+        rhs.plus(-rhs.sum()/geom.Domain().numPts(), 0, 1);
+
+        int nfail = 0;
+        for (int maxorder = 2; maxorder <= 4; ++maxorder)
+        {
+            for (LinOpBCType bc : {LinOpBCType::Periodic, LinOpBCType::Dirichlet})
+            {
+                const Geometry& g = (bc == LinOpBCType::Periodic) ? geom : geom_np;
+                MultiFab sol0 = solve(g, ba, dm, rhs, acoef, bcoef, bc, maxorder, num_iter, false);
+                MultiFab sol1 = solve(g, ba, dm, rhs, acoef, bcoef, bc, maxorder, num_iter, true);
+                MultiFab::Subtract(sol1, sol0, 0, 0, 1, 0);
+                const Real diff = sol1.norm0();
+                const Real norm = sol0.norm0();
+                amrex::Print() << "maxorder " << maxorder
+                               << ((bc == LinOpBCType::Periodic) ? ", periodic " : ", Dirichlet")
+                               << ": |sol| = " << norm << ", |fused - unfused| = " << diff << "\n";
+                if (diff != 0.0 || norm == 0.0) ++nfail;
+            }
+        }
+
+        if (nfail > 0) {
+            amrex::Abort("The fused and unfused smoothers give different results");
+        }
+        amrex::Print() << "The fused and unfused smoothers give identical results\n";
+    }
+    amrex::Finalize();
+}
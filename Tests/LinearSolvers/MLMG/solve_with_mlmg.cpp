@@ -1,6 +1,7 @@
 #include <AMReX_MultiFab.H>
 #include <AMReX_MLMG.H>
 #include <AMReX_MLABecLaplacian.H>
+#include <AMReX_MLLinOpCache.H>
 #include <AMReX_MultiFabUtil.H>
 #include <AMReX_ParmParse.H>
 
@@ -20,6 +21,41 @@ static int linop_maxorder = 2;
 static bool agglomeration = false;
 static bool consolidation = false;
 static int  use_hypre = 0;
+static std::string bottom_solver = "bicgstab";
+static bool fused_smooth = false;
+static bool mixed_precision = false;
+static int nsolves = 1;
+static bool reuse_setup = false;
+static std::string cycle_type = "V";
+static bool adaptive_cycle = false;
+
+MLMG::BottomSolver bottomSolverType ()
+{
+    if (bottom_solver == "cg") {
+        return MLMG::BottomSolver::cg;
+    } else if (bottom_solver == "pipelined_bicgstab") {
+        return MLMG::BottomSolver::pipelined_bicgstab;
+    } else if (bottom_solver == "pipelined_cg") {
+        return MLMG::BottomSolver::pipelined_cg;
+    } else if (bottom_solver == "amg") {
+        return MLMG::BottomSolver::amg;
+    } else if (bottom_solver == "hypre" || use_hypre) {
+        return MLMG::BottomSolver::hypre;
+    } else {
+        return MLMG::BottomSolver::bicgstab;
+    }
+}
+
+MLMG::CycleType cycleType ()
+{
+    if (cycle_type == "W") {
+        return MLMG::CycleType::W;
+    } else if (cycle_type == "F") {
+        return MLMG::CycleType::F;
+    } else {
+        return MLMG::CycleType::V;
+    }
+}
 }
 
 void solve_with_mlmg(const Vector<Geometry>& geom, int ref_ratio,
@@ -44,6 +80,13 @@ void solve_with_mlmg(const Vector<Geometry>& geom, int ref_ratio,
     pp.query("agglomeration", agglomeration);
     pp.query("consolidation", consolidation);
     pp.query("use_hypre", use_hypre);
+    pp.query("bottom_solver", bottom_solver);
+    pp.query("fused_smooth", fused_smooth);
+    pp.query("mixed_precision", mixed_precision);
+    pp.query("nsolves", nsolves);
+    pp.query("reuse_setup", reuse_setup);
+    pp.query("cycle_type", cycle_type);
+    pp.query("adaptive_cycle", adaptive_cycle);
     pp.query("tol_rel", tol_rel);
     pp.query("tol_abs", tol_abs);
   }
@@ -67,36 +110,57 @@ void solve_with_mlmg(const Vector<Geometry>& geom, int ref_ratio,
       prhs.push_back(&(rhs[ilev]));
     }
 
-    MLABecLaplacian mlabec(geom, grids, dmap, info);
-    mlabec.setMaxOrder(linop_maxorder);
-    // BC
-    mlabec.setDomainBC({prob::bc_type, prob::bc_type, prob::bc_type},
-                       {prob::bc_type, prob::bc_type, prob::bc_type});
-    for (int ilev = 0; ilev < nlevels; ++ilev) {
-      mlabec.setLevelBC(ilev, psoln[ilev]);
-    }
-    mlabec.setScalars(prob::a, prob::b);
-    for (int ilev = 0; ilev < nlevels; ++ilev) {
-      mlabec.setACoeffs(ilev, alpha[ilev]);
-      std::array<MultiFab, AMREX_SPACEDIM> bcoefs;
-      for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
-        const BoxArray& ba = amrex::convert(beta[ilev].boxArray(),
-                                            IntVect::TheDimensionVector(idim));
-        bcoefs[idim].define(ba, beta[ilev].DistributionMap(), 1, 0);
+    // Solving more than once stands in for time steps on the same grids.
+    MLLinOpCache<MLABecLaplacian> cache;
+    MLMG::CycleTuning tuning;
+    for (int isolve = 0; isolve < nsolves; ++isolve) {
+      for (auto& mf : soln) {
+        mf.setVal(0.0);
       }
-      amrex::average_cellcenter_to_face(amrex::GetArrOfPtrs(bcoefs),
-                                        beta[ilev], geom[ilev]);
-      mlabec.setBCoeffs(ilev, amrex::GetArrOfConstPtrs(bcoefs));
-    }
 
-    MLMG mlmg(mlabec);
-    mlmg.setMaxIter(max_iter);
-    mlmg.setMaxFmgIter(max_fmg_iter);
-    if (use_hypre) mlmg.setBottomSolver(MLMG::BottomSolver::hypre);
-    mlmg.setVerbose(verbose);
-    mlmg.setBottomVerbose(cg_verbose);
+      std::shared_ptr<MLABecLaplacian> linop = reuse_setup
+          ? cache.get(geom, grids, dmap, info)
+          : std::make_shared<MLABecLaplacian>(geom, grids, dmap, info);
+      MLABecLaplacian& mlabec = *linop;
 
-    mlmg.solve(psoln, prhs, tol_rel, tol_abs);
+      mlabec.setMaxOrder(linop_maxorder);
+      mlabec.setFusedSmooth(fused_smooth);
+      // BC
+      mlabec.setDomainBC({prob::bc_type, prob::bc_type, prob::bc_type},
+                         {prob::bc_type, prob::bc_type, prob::bc_type});
+      for (int ilev = 0; ilev < nlevels; ++ilev) {
+        mlabec.setLevelBC(ilev, psoln[ilev]);
+      }
+      mlabec.setScalars(prob::a, prob::b);
+      for (int ilev = 0; ilev < nlevels; ++ilev) {
+        mlabec.setACoeffs(ilev, alpha[ilev]);
+        std::array<MultiFab, AMREX_SPACEDIM> bcoefs;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+          const BoxArray& ba = amrex::convert(beta[ilev].boxArray(),
+                                              IntVect::TheDimensionVector(idim));
+          bcoefs[idim].define(ba, beta[ilev].DistributionMap(), 1, 0);
+        }
+        amrex::average_cellcenter_to_face(amrex::GetArrOfPtrs(bcoefs),
+                                          beta[ilev], geom[ilev]);
+        mlabec.setBCoeffs(ilev, amrex::GetArrOfConstPtrs(bcoefs));
+      }
+
+      MLMG mlmg(mlabec);
+      mlmg.setMaxIter(max_iter);
+      mlmg.setMaxFmgIter(max_fmg_iter);
+      mlmg.setBottomSolver(bottomSolverType());
+      mlmg.setMixedPrecision(mixed_precision);
+      mlmg.setVerbose(verbose);
+      mlmg.setBottomVerbose(cg_verbose);
+      mlmg.setCycleType(cycleType());
+      mlmg.setAdaptiveCycle(adaptive_cycle);
+      mlmg.setCycleTuning(tuning);
+
+      mlmg.solve(psoln, prhs, tol_rel, tol_abs);
+
+      tuning = mlmg.getCycleTuning();
+    }
+    if (reuse_setup) cache.printStats();
   } else {
     const int levbegin = (fine_leve_solve_only) ? nlevels-1 : 0;
     for (int ilev = 0; ilev < levbegin; ++ilev) {
@@ -110,6 +174,7 @@ void solve_with_mlmg(const Vector<Geometry>& geom, int ref_ratio,
                              info);
 
       mlabec.setMaxOrder(linop_maxorder);
+      mlabec.setFusedSmooth(fused_smooth);
 
       mlabec.setDomainBC({prob::bc_type, prob::bc_type, prob::bc_type},
                          {prob::bc_type, prob::bc_type, prob::bc_type});
@@ -135,6 +200,8 @@ void solve_with_mlmg(const Vector<Geometry>& geom, int ref_ratio,
       MLMG mlmg(mlabec);
       mlmg.setMaxIter(max_iter);
       mlmg.setMaxFmgIter(max_fmg_iter);
+      mlmg.setBottomSolver(bottomSolverType());
+      mlmg.setMixedPrecision(mixed_precision);
       mlmg.setVerbose(verbose);
       mlmg.setBottomVerbose(cg_verbose);
 
@@ -0,0 +1,141 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+//
+// One stage of a Runge-Kutta integrator, done with the chained MultiFab
+// calls and with fused MFExpr expressions.  Compares the results, the
+// time and the memory traffic of both.
+//
+
+namespace {
+
+void init (MultiFab& mf, Real a)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        auto const& p = mf.array(mfi);
+        amrex::LoopOnCpu(mfi.fabbox(), mf.nComp(), [=] (int i, int j, int k, int n) noexcept
+        {
+            p(i,j,k,n) = std::sin(a*i + 0.3*n) * std::cos(0.07*j) + 1.e-3*a*k;
+        });
+    }
+}
+
+Real relDiff (Real a, Real b)
+{
+    return std::abs(a-b) / std::max(std::abs(a), Real(1.e-300));
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 128;
+        int max_grid_size = 64;
+        int ncomp = 2;
+        int nrepeat = 10;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("ncomp", ncomp);
+            pp.query("nrepeat", nrepeat);
+        }
+
+        BoxArray ba(Box(IntVect(0), IntVect(n_cell-1)));
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        MultiFab u(ba, dm, ncomp, 0);
+        MultiFab k1(ba, dm, ncomp, 0);
+        MultiFab k2(ba, dm, ncomp, 0);
+        MultiFab k3(ba, dm, ncomp, 0);
+        MultiFab w(ba, dm, ncomp, 0);
+        MultiFab unew0(ba, dm, ncomp, 0);
+        MultiFab unew1(ba, dm, ncomp, 0);
+        init(u, 0.1);
+        init(k1, 0.2);
+        init(k2, 0.3);
+        init(k3, 0.4);
+        init(w, 0.5);
+        w.plus(2.0, 0, ncomp, 0);
+
+        const Real dt = 1.e-2;
+        const Real b1 = dt/6., b2 = dt*2./3., b3 = dt/6.;
+
+        // unew = u + b1*k1 + b2*k2 + b3*k3, the weighted norm of the
+        // change, the dot product with u and the max norm of unew.
+        Real r0[4], r1[4];
+
+        ParallelDescriptor::Barrier();
+        Real t0 = amrex::second();
+        for (int n = 0; n < nrepeat; ++n)
+        {
+            MultiFab::LinComb(unew0, 1.0, u, 0, b1, k1, 0, 0, ncomp, 0);
+            MultiFab::Saxpy(unew0, b2, k2, 0, 0, ncomp, 0);
+            MultiFab::Saxpy(unew0, b3, k3, 0, 0, ncomp, 0);
+            MultiFab du(ba, dm, ncomp, 0);
+            MultiFab::Copy(du, unew0, 0, 0, ncomp, 0);
+            MultiFab::Subtract(du, u, 0, 0, ncomp, 0);
+            MultiFab::Multiply(du, w, 0, 0, ncomp, 0);
+            r0[0] = std::sqrt(MultiFab::Dot(du, 0, ncomp, 0));
+            r0[1] = MultiFab::Dot(unew0, 0, u, 0, ncomp, 0);
+            Real mx = 0.;
+            for (int icomp = 0; icomp < ncomp; ++icomp) {
+                mx = std::max(mx, unew0.norm0(icomp));
+            }
+            r0[2] = mx;
+            r0[3] = unew0.norm1(0);
+        }
+        Real t_chained = amrex::second() - t0;
+
+        ParallelDescriptor::Barrier();
+        t0 = amrex::second();
+        for (int n = 0; n < nrepeat; ++n)
+        {
+            unew1 = u + b1*k1 + b2*k2 + b3*k3;
+            auto r = MFExpr::reduce(MFExpr::norm2((unew1-u)*w),
+                                    MFExpr::dot(unew1,u),
+                                    MFExpr::norm0(unew1),
+                                    MFExpr::norm1(MFExpr::comp(unew1,0)));
+            for (int i = 0; i < 4; ++i) { r1[i] = r[i]; }
+        }
+        Real t_fused = amrex::second() - t0;
+
+        ParallelDescriptor::ReduceRealMax(t_chained);
+        ParallelDescriptor::ReduceRealMax(t_fused);
+
+        // Passes over a MultiFab of ncomp components: LinComb 3, Saxpy 3+3,
+        // du 2+3+3, Dot 1+2, norm0 1, norm1 1/ncomp; or 5 for the
+        // expression and 3 for the reductions, which read unew1, u and w
+        // once.
+        const Real nbytes = Real(ba.numPts())*ncomp*sizeof(Real);
+        const Real passes_chained = 3+6+8+3+1+1./ncomp;
+        const Real passes_fused = 5+3;
+        amrex::Print() << "Chained MultiFab calls: " << t_chained/nrepeat << " seconds, "
+                       << passes_chained*nbytes/1.e6 << " MB moved, "
+                       << ncomp+3 << " allreduces\n"
+                       << "Fused expressions:      " << t_fused/nrepeat << " seconds, "
+                       << passes_fused*nbytes/1.e6 << " MB moved, 1 allreduce\n";
+
+        MultiFab::Subtract(unew1, unew0, 0, 0, ncomp, 0);
+        const Real diff = unew1.norm0();
+        Real rdiff = 0.;
+        for (int i = 0; i < 4; ++i) {
+            rdiff = std::max(rdiff, relDiff(r0[i], r1[i]));
+        }
+        amrex::Print() << "Max difference: assignment " << diff
+                       << ", relative in reductions " << rdiff << "\n";
+        if (diff > 1.e-14 || rdiff > 1.e-12) {
+            amrex::Abort("The fused expressions give different results");
+        }
+        amrex::Print() << "The fused expressions give the same results\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,60 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+//
+// Count the ghost cells a FillBoundary has to get from boxes on another
+// node.  With DistributionMapping.node_size, nodes of that many consecutive
+// ranks are assumed.  Otherwise every rank is its own node.
+//
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 128;
+        int max_grid_size = 16;
+        int ngrow = 2;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("ngrow", ngrow);
+        }
+        int node_size = 1;
+        {
+            ParmParse pp("DistributionMapping");
+            pp.query("node_size", node_size);
+            node_size = std::max(node_size, 1);
+        }
+
+        Box domain(IntVect(0), IntVect(n_cell-1));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+
+        DistributionMapping dm(ba);
+
+        long inter = 0, intra = 0;
+        std::vector<std::pair<int,Box> > isects;
+        for (int i = 0, N = ba.size(); i < N; ++i)
+        {
+            ba.intersections(amrex::grow(ba[i],ngrow), isects);
+            for (const auto& is : isects)
+            {
+                const int j = is.first;
+                if (j == i) continue;
+                if (dm[i]/node_size != dm[j]/node_size) {
+                    inter += is.second.numPts();
+                } else if (dm[i] != dm[j]) {
+                    intra += is.second.numPts();
+                }
+            }
+        }
+
+        amrex::Print() << "Ghost cells from other nodes: " << inter << "\n"
+                       << "Ghost cells from the same node: " << intra << "\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,159 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+//
+// Checks the non-blocking reductions of ParallelDescriptor against the
+// blocking ones, and times a reduction overlapped with FillBoundary
+// against the same reduction followed by FillBoundary.
+//
+
+namespace {
+
+void init (MultiFab& mf)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        auto const& p = mf.array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [=] (int i, int j, int k) noexcept
+        {
+            p(i,j,k) = std::sin(0.1*i) * std::cos(0.07*j) + 1.e-3*k;
+        });
+    }
+}
+
+void check (bool ok, const char* what)
+{
+    if (!ok) {
+        amrex::Abort(std::string("NonBlockingReduce: wrong result for ") + what);
+    }
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 128;
+        int max_grid_size = 32;
+        int nghost = 2;
+        int nrepeat = 20;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("nghost", nghost);
+            pp.query("nrepeat", nrepeat);
+        }
+
+        BoxArray ba(Box(IntVect(0), IntVect(n_cell-1)));
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        MultiFab mf(ba, dm, 1, nghost);
+        mf.setVal(0.0);
+        init(mf);
+
+        const int myproc = ParallelDescriptor::MyProc();
+
+        // Scalars and arrays of each type.
+        {
+            Real rs = mf.sum(0,true), rmx = mf.max(0,0,true), rmn = mf.min(0,0,true);
+            long ls = myproc+1, lmx = myproc, lmn = -myproc;
+            int is[2] = {myproc, 2*myproc};
+
+            auto frs = ParallelDescriptor::IReduceRealSum(rs);
+            auto frmx = ParallelDescriptor::IReduceRealMax(rmx);
+            auto frmn = ParallelDescriptor::IReduceRealMin(rmn);
+            auto fls = ParallelDescriptor::IReduceLongSum(ls);
+            auto flmx = ParallelDescriptor::IReduceLongMax(lmx);
+            auto flmn = ParallelDescriptor::IReduceLongMin(lmn);
+            auto fis = ParallelDescriptor::IReduceIntSum(is, 2);
+            auto fpa = ParallelAllReduce::ISum(rs, ParallelDescriptor::Communicator());
+
+            // A moved future keeps its request.
+            auto fis2 = std::move(fis);
+
+            ParallelDescriptor::ReduceRealSum(rs);
+            ParallelDescriptor::ReduceRealMax(rmx);
+            ParallelDescriptor::ReduceRealMin(rmn);
+            ParallelDescriptor::ReduceLongSum(ls);
+            ParallelDescriptor::ReduceLongMax(lmx);
+            ParallelDescriptor::ReduceLongMin(lmn);
+            ParallelDescriptor::ReduceIntSum(is, 2);
+
+            check(frs.get() == rs, "IReduceRealSum");
+            check(frmx.get() == rmx, "IReduceRealMax");
+            check(frmn.get() == rmn, "IReduceRealMin");
+            check(fls.get() == ls, "IReduceLongSum");
+            check(flmx.get() == lmx, "IReduceLongMax");
+            check(flmn.get() == lmn, "IReduceLongMin");
+            check(fis2.get(0) == is[0] && fis2.get(1) == is[1], "IReduceIntSum");
+            check(fpa.get() == rs, "ParallelAllReduce::ISum");
+        }
+
+        // The combined reduction.
+        {
+            Real sums[2] = { mf.sum(0,true), Real(myproc) };
+            Real maxs[1] = { mf.max(0,0,true) };
+            Real mins[2] = { mf.min(0,0,true), Real(-myproc) };
+
+            auto f = ParallelDescriptor::IReduceRealSumMaxMin(sums, 2, maxs, 1, mins, 2);
+            while (!f.test()) {}
+
+            ParallelDescriptor::ReduceRealSum(sums, 2);
+            ParallelDescriptor::ReduceRealMax(maxs, 1);
+            ParallelDescriptor::ReduceRealMin(mins, 2);
+
+            Real r[5];
+            f.getAll(r);
+            check(f.size() == 5, "IReduceRealSumMaxMin size");
+            check(r[0] == sums[0] && r[1] == sums[1] && r[2] == maxs[0] &&
+                  r[3] == mins[0] && r[4] == mins[1], "IReduceRealSumMaxMin");
+        }
+
+        // A norm and FillBoundary, one after the other and overlapped.
+        Real r0 = 0, r1 = 0;
+
+        ParallelDescriptor::Barrier();
+        Real t0 = amrex::second();
+        for (int n = 0; n < nrepeat; ++n)
+        {
+            Real s[1] = { mf.sum(0,true) };
+            Real m[1] = { mf.norm0(0,0,true) };
+            ParallelDescriptor::ReduceRealSum(s, 1);
+            ParallelDescriptor::ReduceRealMax(m, 1);
+            r0 = s[0] + m[0];
+            mf.FillBoundary();
+        }
+        Real t_blocking = amrex::second() - t0;
+
+        ParallelDescriptor::Barrier();
+        t0 = amrex::second();
+        for (int n = 0; n < nrepeat; ++n)
+        {
+            Real s = mf.sum(0,true);
+            Real m = mf.norm0(0,0,true);
+            auto f = ParallelDescriptor::IReduceRealSumMaxMin(&s, 1, &m, 1, nullptr, 0);
+            mf.FillBoundary();
+            r1 = f.get(0) + f.get(1);
+        }
+        Real t_overlap = amrex::second() - t0;
+
+        check(r0 == r1, "the overlapped reduction");
+
+        ParallelDescriptor::ReduceRealMax(t_blocking);
+        ParallelDescriptor::ReduceRealMax(t_overlap);
+        amrex::Print() << "Blocking reductions then FillBoundary: " << t_blocking/nrepeat
+                       << " seconds, 2 allreduces\n"
+                       << "Reduction overlapped with FillBoundary: " << t_overlap/nrepeat
+                       << " seconds, 1 allreduce\n"
+                       << "The non-blocking reductions give the same results\n";
+    }
+    amrex::Finalize();
+}
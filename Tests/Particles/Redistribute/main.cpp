@@ -223,6 +223,7 @@ struct TestParams
     int do_random;
     int nsteps;
     int do_regrid;
+    int do_global;
 };
 
 void testRedistribute();
@@ -248,6 +249,8 @@ void get_test_params(TestParams& params, const std::string& prefix)
     pp.get("do_random", params.do_random);    
     pp.get("nsteps", params.nsteps);
     pp.get("do_regrid", params.do_regrid);
+    params.do_global = 0;
+    pp.query("do_global", params.do_global);
 }
 
 void testRedistribute ()
@@ -289,13 +292,30 @@ void testRedistribute ()
 
     auto np_old = pc.TotalNumberOfParticles();
     
+    Real redist_time = 0.;
     for (int i = 0; i < params.nsteps; ++i)
     {
         pc.moveParticles(params.move_dir, params.do_random);
-        pc.RedistributeLocal();
+        ParallelDescriptor::Barrier();
+        Real t0 = amrex::second();
+        if (params.do_global) {
+            pc.RedistributeGlobal();
+        } else {
+            pc.RedistributeLocal();
+        }
+        redist_time += amrex::second() - t0;
         pc.checkAnswer();
     }
 
+    // For the scaling of the handshake with the number of ranks, see
+    // scaling.sh, which runs inputs.scaling with and without
+    // particles.use_nbx_handshake.
+    ParallelDescriptor::ReduceRealMax(redist_time);
+    amrex::Print() << "Ranks: " << ParallelDescriptor::NProcs()
+                   << ", " << (params.do_global ? "global" : "local")
+                   << " Redistribute time per step: "
+                   << redist_time/std::max(params.nsteps,1) << " seconds\n";
+
     if (params.do_regrid)
     {
         {
@@ -0,0 +1,20 @@
+#!/bin/bash
+#
+# Time per step of a global Redistribute versus the number of ranks, with
+# the MPI_Alltoall handshake and with the sparse NBX handshake.
+#
+# Usage: ./scaling.sh [executable] [max ranks]
+
+EXE=${1:-./main3d.gnu.TPROF.MPI.ex}
+MAXRANKS=${2:-64}
+MPIRUN=${MPIRUN:-mpirun}
+
+np=1
+while [ $np -le $MAXRANKS ]; do
+    for nbx in 0 1; do
+        echo -n "use_nbx_handshake = $nbx: "
+        ${MPIRUN} -np $np ${EXE} inputs.scaling particles.use_nbx_handshake=$nbx \
+            | grep "Redistribute time per step"
+    done
+    np=$((np*2))
+done
@@ -0,0 +1,181 @@
+#include <iostream>
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Particles.H>
+
+using namespace amrex;
+
+//
+// Times AssignCellDensitySingleLevel and InterpolateSingleLevel on randomly
+// ordered particles, sorts them with SortParticlesByCell and times them
+// again.  Run it under e.g. "perf stat -e cache-misses" with one of the
+// phases disabled to count the cache misses saved by sorting.
+//
+
+struct TestParams {
+  int nx;
+  int ny;
+  int nz;
+  int max_grid_size;
+  int nppc;
+  int nreps;
+  IntVect bin_size;
+};
+
+typedef ParticleContainer<1 + BL_SPACEDIM> MyParticleContainer;
+
+namespace {
+
+void time_kernels (MyParticleContainer& myPC, MultiFab& partMF, MultiFab& acceleration,
+                   int nreps, const std::string& label)
+{
+  Real t_assign = 0.0;
+  Real t_interp = 0.0;
+  for (int i = 0; i < nreps; ++i)
+  {
+    partMF.setVal(0.0);
+    ParallelDescriptor::Barrier();
+    Real t0 = ParallelDescriptor::second();
+    myPC.AssignCellDensitySingleLevel(0, partMF, 0, 4, 0);
+    ParallelDescriptor::Barrier();
+    Real t1 = ParallelDescriptor::second();
+    myPC.InterpolateSingleLevel(acceleration, 0);
+    ParallelDescriptor::Barrier();
+    Real t2 = ParallelDescriptor::second();
+    t_assign += t1 - t0;
+    t_interp += t2 - t1;
+  }
+
+  ParallelDescriptor::ReduceRealMax(t_assign);
+  ParallelDescriptor::ReduceRealMax(t_interp);
+
+  amrex::Print() << label << ": AssignCellDensitySingleLevel " << t_assign/nreps
+                 << " s, InterpolateSingleLevel " << t_interp/nreps << " s\n";
+}
+
+bool check_bins (MyParticleContainer& myPC, const IntVect& bin_size)
+{
+  const Geometry& geom = myPC.Geom(0);
+  const auto plo = geom.ProbLoArray();
+  const auto dxi = geom.InvCellSizeArray();
+  const Box domain = geom.Domain();
+
+  int nbad = 0;
+  Gpu::ManagedDeviceVector<int> bin_start, bin_stop;
+  for (MyParticleContainer::ParIterType pti(myPC, 0); pti.isValid(); ++pti)
+  {
+    myPC.SortParticlesByBin(pti, 0, bin_start, bin_stop, bin_size);
+
+    const Box bx = pti.tilebox();
+    const auto& aos = pti.GetArrayOfStructs();
+    for (int b = 0; b < static_cast<int>(bin_start.size()); ++b)
+    {
+      for (int i = bin_start[b]; i < bin_stop[b]; ++i)
+      {
+        IntVect iv = getParticleCell(aos[i], plo, dxi, domain);
+        Box tbx;
+        if (getTileIndex(iv, bx, true, bin_size, tbx) != b) ++nbad;
+      }
+    }
+    if (bin_stop.back() != pti.numParticles()) ++nbad;
+  }
+
+  ParallelDescriptor::ReduceIntSum(nbad);
+  return nbad == 0;
+}
+
+}
+
+void test_sort_particles (TestParams& parms)
+{
+  RealBox real_box;
+  for (int n = 0; n < BL_SPACEDIM; n++) {
+    real_box.setLo(n, 0.0);
+    real_box.setHi(n, 1.0);
+  }
+
+  IntVect domain_lo(AMREX_D_DECL(0, 0, 0));
+  IntVect domain_hi(AMREX_D_DECL(parms.nx - 1, parms.ny - 1, parms.nz-1));
+  const Box domain(domain_lo, domain_hi);
+
+  int is_per[BL_SPACEDIM];
+  for (int i = 0; i < BL_SPACEDIM; i++)
+    is_per[i] = 1;
+  Geometry geom(domain, &real_box, CoordSys::cartesian, is_per);
+
+  BoxArray ba(domain);
+  ba.maxSize(parms.max_grid_size);
+
+  DistributionMapping dmap(ba);
+
+  MultiFab acceleration(ba, dmap, 3, 1);
+  acceleration.setVal(5.0, 1);
+
+  MultiFab partMF(ba, dmap, 1 + BL_SPACEDIM, 1);
+
+  MyParticleContainer myPC(geom, dmap, ba);
+  myPC.SetVerbose(false);
+
+  long num_particles = long(parms.nppc) * parms.nx * parms.ny * parms.nz;
+  amrex::Print() << "Total number of particles    : " << num_particles << "\n\n";
+
+  bool serialize = true;
+  int iseed = 451;
+  Real mass = 10.0;
+
+  MyParticleContainer::ParticleInitData pdata = {mass, AMREX_D_DECL(1.0, 2.0, 3.0)};
+  myPC.InitRandom(num_particles, iseed, pdata, serialize);
+
+  time_kernels(myPC, partMF, acceleration, parms.nreps, "Unsorted");
+  const Real mass_before = partMF.sum(0);
+
+  Real t0 = ParallelDescriptor::second();
+  myPC.SortParticlesByCell();
+  Real t_sort = ParallelDescriptor::second() - t0;
+  ParallelDescriptor::ReduceRealMax(t_sort);
+  amrex::Print() << "SortParticlesByCell: " << t_sort << " s\n";
+
+  time_kernels(myPC, partMF, acceleration, parms.nreps, "Sorted  ");
+  const Real mass_after = partMF.sum(0);
+
+  amrex::Print() << "Deposited mass before and after sorting: "
+                 << mass_before << " " << mass_after << "\n";
+  if (std::abs(mass_before-mass_after) > 1.e-10*std::abs(mass_before)) {
+    amrex::Abort("SortParticlesByCell changed the deposited mass");
+  }
+
+  if (!check_bins(myPC, parms.bin_size)) {
+    amrex::Abort("SortParticlesByBin produced inconsistent bins");
+  }
+  amrex::Print() << "SortParticlesByBin bins are consistent\n";
+}
+
+int main(int argc, char* argv[])
+{
+  amrex::Initialize(argc,argv);
+
+  {
+    ParmParse pp;
+
+    TestParams parms;
+
+    pp.get("nx", parms.nx);
+    pp.get("ny", parms.ny);
+    pp.get("nz", parms.nz);
+    pp.get("max_grid_size", parms.max_grid_size);
+    pp.get("nppc", parms.nppc);
+    parms.nreps = 10;
+    pp.query("nreps", parms.nreps);
+    parms.bin_size = IntVect(AMREX_D_DECL(4,4,4));
+    Vector<int> bs;
+    if (pp.queryarr("bin_size", bs)) {
+      for (int i = 0; i < BL_SPACEDIM; ++i) parms.bin_size[i] = bs[i];
+    }
+
+    test_sort_particles(parms);
+  }
+
+  amrex::Finalize();
+}
@@ -0,0 +1,203 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_EB2.H>
+#include <AMReX_EBFabFactory.H>
+#include <AMReX_MultiCutFab.H>
+#include <AMReX_SparseCutFab.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+//
+// Compare the EB data of a factory that stores the cut cell data densely
+// with one that stores it sparsely, and report the memory of both.
+//
+
+namespace {
+
+long denseBytes (const MultiCutFab& mcf)
+{
+    long r = 0;
+    for (MFIter mfi(mcf.data()); mfi.isValid(); ++mfi) {
+        if (mcf.ok(mfi)) {
+            r += mcf[mfi].nBytes();
+        }
+    }
+    ParallelDescriptor::ReduceLongSum(r);
+    return r;
+}
+
+long sparseBytes (const MultiSparseCutFab& mscf)
+{
+    long r = mscf.nBytes();
+    ParallelDescriptor::ReduceLongSum(r);
+    return r;
+}
+
+// Number of values that differ between the dense data, the sparse
+// accessor, the dense data scattered from the sparse one and the fabs
+// scattered one box at a time.
+long numDiffs (const MultiCutFab& dense, const MultiSparseCutFab& sparse,
+               const MultiCutFab& scattered, const EBCutData& cutdata)
+{
+    long n = 0;
+    for (MFIter mfi(dense.data()); mfi.isValid(); ++mfi)
+    {
+        if (!dense.ok(mfi)) continue;
+        const Box& bx = dense[mfi].box();
+        FArrayBox tmp;
+        const FArrayBox& fab = cutdata.fab(mfi, amrex::enclosedCells(bx), tmp);
+        AMREX_ALWAYS_ASSERT(fab.box() == bx);
+        auto const& d = dense.const_array(mfi);
+        auto const& s = scattered.const_array(mfi);
+        auto const& a = sparse.const_array(mfi);
+        auto const& f = fab.const_array();
+        const int ncomp = dense.nComp();
+        amrex::LoopOnCpu(bx, ncomp, [&] (int i, int j, int k, int m) noexcept
+        {
+            if (d(i,j,k,m) != s(i,j,k,m) || d(i,j,k,m) != a(i,j,k,m) ||
+                d(i,j,k,m) != f(i,j,k,m)) ++n;
+        });
+    }
+    ParallelDescriptor::ReduceLongSum(n);
+    return n;
+}
+
+// EB2 flags the cells next to covered cells as cut, but flags made in
+// other ways may have a face between a regular and a covered cell.  That
+// face must read as covered.
+bool coveredFacesOK ()
+{
+    const Box bx(IntVect(0), IntVect(7));
+    BoxArray ba(bx);
+    DistributionMapping dm(ba);
+    FabArray<EBCellFlagFab> flags(ba, dm, 1, 0, MFInfo(), DefaultFabFactory<EBCellFlagFab>());
+    for (MFIter mfi(flags); mfi.isValid(); ++mfi)
+    {
+        // Covered cells at i = 4 and 5, and one cut cell so that the box
+        // is stored.
+        auto const& f = flags[mfi].array();
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k) noexcept
+        {
+            EBCellFlag flag;
+            if (i == 0 && j == 0 && k == 0) {
+                flag.setSingleValued();
+            } else if (i == 4 || i == 5) {
+                flag.setCovered();
+            } else {
+                flag.setRegular();
+            }
+            f(i,j,k) = flag;
+        });
+        flags[mfi].setType(FabType::singlevalued);
+    }
+
+    MultiSparseCutFab area(flags, IndexType(IntVect::TheDimensionVector(0)), 1, 1.0, 0.0);
+    bool ok = true;
+    for (MFIter mfi(flags); mfi.isValid(); ++mfi)
+    {
+        auto const& a = area.const_array(mfi);
+        ok = ok && a(3,3,3) == 1.0 && a(4,3,3) == 0.0 && a(5,3,3) == 0.0
+                && a(6,3,3) == 0.0 && a(7,3,3) == 1.0;
+    }
+    ParallelDescriptor::ReduceBoolAnd(ok);
+    return ok;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 128;
+        int max_grid_size = 32;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        Geometry geom;
+        {
+            RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+            Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(0,0,0)};
+            Box domain(IntVect(0), IntVect(n_cell-1));
+            geom.define(domain, rb, CoordSys::cartesian, is_periodic);
+        }
+
+        EB2::Build(geom, 0, 0);
+
+        BoxArray ba(geom.Domain());
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+        const Vector<int> ngrow{4,4,4};
+
+        ParmParse pp("eb2");
+        pp.add("sparse_cut_data", 0);
+        auto dense = makeEBFabFactory(geom, ba, dm, ngrow, EBSupport::full);
+        pp.add("sparse_cut_data", 1);
+        auto sparse = makeEBFabFactory(geom, ba, dm, ngrow, EBSupport::full);
+
+        AMREX_ALWAYS_ASSERT(sparse->getSparseCentroid().indexMaps() ==
+                            sparse->getSparseBndryArea().indexMaps());
+
+        long nbytes_dense = 0, nbytes_sparse = 0, ndiffs = 0;
+        auto check = [&] (const std::string& name, const MultiCutFab& d,
+                          const MultiSparseCutFab& s, const MultiCutFab& scattered,
+                          const EBCutData& cutdata)
+        {
+            const long nd = denseBytes(d);
+            const long ns = sparseBytes(s);
+            const long n = numDiffs(d, s, scattered, cutdata);
+            amrex::Print() << name << ": dense " << nd << " bytes, sparse " << ns
+                           << " bytes, " << n << " values differ\n";
+            nbytes_dense += nd;
+            nbytes_sparse += ns;
+            ndiffs += n;
+        };
+
+        check("Centroid  ", dense->getCentroid(), sparse->getSparseCentroid(),
+              sparse->getCentroid(), sparse->getCentroidData());
+        check("BndryCent ", dense->getBndryCent(), sparse->getSparseBndryCent(),
+              sparse->getBndryCent(), sparse->getBndryCentData());
+        check("BndryArea ", dense->getBndryArea(), sparse->getSparseBndryArea(),
+              sparse->getBndryArea(), sparse->getBndryAreaData());
+        check("BndryNorm ", dense->getBndryNormal(), sparse->getSparseBndryNormal(),
+              sparse->getBndryNormal(), sparse->getBndryNormalData());
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            check("AreaFrac_"+std::to_string(idim), *dense->getAreaFrac()[idim],
+                  *sparse->getSparseAreaFrac()[idim], *sparse->getAreaFrac()[idim],
+                  sparse->getAreaFracData()[idim]);
+            check("FaceCent_"+std::to_string(idim), *dense->getFaceCent()[idim],
+                  *sparse->getSparseFaceCent()[idim], *sparse->getFaceCent()[idim],
+                  sparse->getFaceCentData()[idim]);
+        }
+
+        long nbytes_map = 0;
+        {
+            const auto& maps = *sparse->getSparseCentroid().indexMaps();
+            for (const auto& m : maps) {
+                nbytes_map += m.nBytes();
+            }
+            ParallelDescriptor::ReduceLongSum(nbytes_map);
+        }
+
+        amrex::Print() << "Dense cut cell data: " << nbytes_dense << " bytes\n"
+                       << "Sparse cut cell data: " << nbytes_sparse << " bytes + "
+                       << nbytes_map << " bytes of index maps, "
+                       << Real(nbytes_dense)/Real(nbytes_sparse+nbytes_map)
+                       << " times less\n";
+
+        if (!coveredFacesOK()) {
+            amrex::Abort("A face between a regular and a covered cell is not covered");
+        }
+
+        if (ndiffs != 0) {
+            amrex::Abort("The sparse cut cell data differ from the dense data");
+        }
+        amrex::Print() << "The sparse cut cell data are identical\n";
+    }
+    amrex::Finalize();
+}
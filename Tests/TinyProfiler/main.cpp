@@ -0,0 +1,110 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_BLProfiler.H>
+#include <AMReX_Print.H>
+#include <AMReX_Utility.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace amrex;
+
+//
+// Time nested timers inside and outside of OpenMP parallel regions, and
+// measure the cost of starting and stopping a timer.
+//
+
+namespace {
+
+double work (int n)
+{
+    double x = 0.0;
+    for (int i = 0; i < n; ++i) {
+        x += std::sqrt(double(i));
+    }
+    return x;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        BL_PROFILE("main()");
+
+        int nouter = 10;
+        int ninner = 64;
+        int nwork = 20000;
+        int ntimers = 1000000;
+        {
+            ParmParse pp;
+            pp.query("nouter", nouter);
+            pp.query("ninner", ninner);
+            pp.query("work", nwork);
+            pp.query("ntimers", ntimers);
+        }
+
+        double sum = 0.0;
+        for (int i = 0; i < nouter; ++i)
+        {
+            BL_PROFILE("outer");
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:sum)
+#endif
+            {
+                BL_PROFILE("parallel region");
+                int tid = 0;
+#ifdef _OPENMP
+                tid = omp_get_thread_num();
+#endif
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+                for (int j = 0; j < ninner; ++j)
+                {
+                    BL_PROFILE("inner");
+                    sum += work(nwork*(1+tid));
+                }
+            }
+        }
+        amrex::Print() << "Sum = " << sum << "\n";
+
+#ifdef AMREX_TINY_PROFILING
+        // A timer started in a region that ends before the timer stops
+        // still counts for the region, every time.
+        for (int i = 0; i < nouter; ++i)
+        {
+            TinyProfiler::StartRegion("Short");
+            BL_PROFILE_VAR("outlives region", outlives);
+            sum += work(nwork);
+            TinyProfiler::StopRegion("Short");
+            sum += work(nwork);
+            BL_PROFILE_VAR_STOP(outlives);
+        }
+#endif
+
+        {
+            BL_PROFILE_REGION("Overhead");
+
+            double t0 = amrex::second();
+            for (int i = 0; i < ntimers; ++i) {
+                BL_PROFILE("empty");
+            }
+            double t = amrex::second() - t0;
+            amrex::Print() << "Time per timer: " << t/ntimers*1.e9 << " ns\n";
+
+#ifdef AMREX_TINY_PROFILING
+            static const int id = TinyProfiler::RegisterTimer("empty with id");
+            t0 = amrex::second();
+            for (int i = 0; i < ntimers; ++i) {
+                TinyProfiler tp(id);
+            }
+            t = amrex::second() - t0;
+            amrex::Print() << "Time per timer with id: " << t/ntimers*1.e9 << " ns\n";
+#endif
+        }
+    }
+    amrex::Finalize();
+}